@@ -0,0 +1,10 @@
+# Times full collections of `gc_large_heap.mnl` against the count of GC threads. Run it from the repo root after a build.
+# A low heap growth percentage makes every round of the script run a full collection.
+# Usage: bash ./benchmarks/gc_threads.sh [minuetm-path]
+
+minuetm="${1:-./build/src/minuetm}"
+
+for thread_count in 1 2 4 8; do
+    echo "GC threads: $thread_count"
+    "$minuetm" run ./benchmarks/gc_large_heap.mnl --gc-growth 110 --gc-threads "$thread_count" | grep "Finished\|GC pauses"
+done
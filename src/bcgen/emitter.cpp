@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <iostream>
 #include <print>
 #include <utility>
 #include <set>
 #include <stack>
+#include <map>
 
 #include "ir/steps.hpp"
 #include "ir/cfg.hpp"
@@ -20,11 +22,91 @@ namespace Minuet::Codegen {
     using Runtime::Code::Chunk;
     using Runtime::Code::Program;
 
+    /// NOTE: Gives the position of an instruction's absolute jump target arg, or `-1` for non-jumps.
+    [[nodiscard]] static auto jump_target_pos_of(Opcode op) noexcept -> int {
+        switch (op) {
+            case Opcode::jump: return 0;
+            case Opcode::jump_if:
+            case Opcode::jump_else: return 1;
+            default: return (op >= Opcode::jeq && op <= Opcode::jnge) ? 2 : -1;
+        }
+    }
+
+    [[nodiscard]] static auto arg_mode_at(const Instruction& inst, int arg_pos) noexcept -> ArgMode {
+        return static_cast<ArgMode>((inst.metadata >> (2 + 4 * arg_pos)) & 0b1111);
+    }
+
+    /**
+     * @brief Summarizes a chunk for the peephole passes: which IPs are jumped to, and how many times each register appears as any instruction's arg.
+     */
+    [[nodiscard]] static auto scan_chunk_uses(const Chunk& chunk) -> std::pair<std::set<int>, std::map<int16_t, int>> {
+        std::set<int> jump_target_ips;
+        std::map<int16_t, int> reg_use_counts;
+
+        for (const auto& inst : chunk) {
+            if (const auto target_pos = jump_target_pos_of(inst.op); target_pos != -1) {
+                jump_target_ips.insert(inst.args[target_pos]);
+            }
+
+            for (auto arg_pos = 0; arg_pos < Runtime::Code::instruct_arity(inst); ++arg_pos) {
+                if (arg_mode_at(inst, arg_pos) == ArgMode::reg) {
+                    ++reg_use_counts[inst.args[arg_pos]];
+                }
+            }
+        }
+
+        return {jump_target_ips, reg_use_counts};
+    }
+
+    /// NOTE: Counts the registers a chunk needs: one past the highest register any instruction names.
+    [[nodiscard]] static auto count_frame_temps(const Chunk& chunk) noexcept -> int16_t {
+        int16_t temp_count = 0;
+
+        for (const auto& inst : chunk) {
+            for (auto arg_pos = 0; arg_pos < Runtime::Code::instruct_arity(inst); ++arg_pos) {
+                if (arg_mode_at(inst, arg_pos) == ArgMode::reg) {
+                    temp_count = std::max<int16_t>(temp_count, inst.args[arg_pos] + 1);
+                }
+            }
+        }
+
+        return temp_count;
+    }
+
+    /**
+     * @brief Drops the marked instructions from a chunk, then remaps every jump target to the shifted IPs. Marked instructions must not be jump targets.
+     */
+    static void erase_marked_instructions(Chunk& chunk, const std::vector<bool>& marks) {
+        const int old_chunk_len = chunk.size();
+        Chunk result;
+        std::vector<int> new_ips (old_chunk_len + 1, 0);
+
+        result.reserve(old_chunk_len);
+
+        for (auto old_ip = 0; old_ip < old_chunk_len; ++old_ip) {
+            new_ips[old_ip] = result.size();
+
+            if (!marks[old_ip]) {
+                result.emplace_back(chunk[old_ip]);
+            }
+        }
+
+        new_ips[old_chunk_len] = result.size();
+
+        for (auto& inst : result) {
+            if (const auto target_pos = jump_target_pos_of(inst.op); target_pos != -1 && inst.args[target_pos] >= 0 && inst.args[target_pos] <= old_chunk_len) {
+                inst.args[target_pos] = new_ips[inst.args[target_pos]];
+            }
+        }
+
+        chunk = std::move(result);
+    }
+
     Emitter::Emitter()
     : m_result_chunks {}, m_active_ifs {}, m_active_loops {}, m_next_fun_id {0} {}
 
     auto Emitter::operator()(FullIR& ir) -> std::optional<Program> {
-        auto& [ir_cfgs, ir_constants, ir_main_fn_id] = ir;
+        auto& [ir_cfgs, ir_constants, ir_function_ids, ir_main_fn_id] = ir;
 
         auto cfg_count = 0;
         for (const auto& cfg : ir_cfgs) {
@@ -36,9 +118,28 @@ namespace Minuet::Codegen {
             ++cfg_count;
         }
 
+        std::vector<Runtime::Code::FrameLayout> frames;
+
+        for (auto chunk_id = 0UL; auto& chunk : m_result_chunks) {
+            lower_compound_assigns(chunk, ir.constants);
+            fuse_compare_jumps(chunk);
+
+            const auto param_count = ir_cfgs[chunk_id].param_count();
+
+            frames.emplace_back(Runtime::Code::FrameLayout {
+                .param_count = param_count,
+                .temp_count = std::max(param_count, count_frame_temps(chunk)),
+            });
+
+            ++chunk_id;
+        }
+
         return Program {
             .chunks = std::exchange(m_result_chunks, {}),
+            .frames = std::move(frames),
             .constants = std::exchange(ir.constants, {}),
+            .feedback = {},
+            .function_ids = std::exchange(ir_function_ids, {}),
             .entry_id = ir.main_id,
         };
     }
@@ -97,6 +198,14 @@ namespace Minuet::Codegen {
                 .op = Opcode::mov,
             });
 
+            return true;
+        } else if (op == Op::seq_len) {
+            m_result_chunks.back().emplace_back(Instruction {
+                .args = {dest.value, arg_0.value, 0},
+                .metadata = encode_metadata(dest, arg_0),
+                .op = Opcode::seq_len,
+            });
+
             return true;
         } else if (op == Op::neg) {
             if (dest == arg_0) {
@@ -185,6 +294,12 @@ namespace Minuet::Codegen {
                 .metadata = Utils::encode_metadata(),
                 .op = Opcode::nop,
             });
+        } else if (op == Op::yield) {
+            m_result_chunks.back().emplace_back(Instruction {
+                .args = {0, 0, 0},
+                .metadata = Utils::encode_metadata(),
+                .op = Opcode::yield,
+            });
         } else if (op == Op::meta_begin_while) {
             const int starting_nop_ip = m_result_chunks.back().size();
 
@@ -307,8 +422,6 @@ namespace Minuet::Codegen {
             switch (ir_op) {
                 case Op::jump_if: return Opcode::jump_if;
                 case Op::jump_else: return Opcode::jump_else;
-                case Op::call: return Opcode::call;
-                case Op::native_call: return Opcode::native_call;
                 default: return {};
             }
         })(op);
@@ -346,7 +459,12 @@ namespace Minuet::Codegen {
         const auto opcode_opt = ([](Op op) noexcept -> std::optional<Opcode> {
             switch (op) {
             case Op::seq_obj_push: return Opcode::seq_obj_push;
+            case Op::seq_obj_pop: return Opcode::seq_obj_pop;
             case Op::seq_obj_get: return Opcode::seq_obj_get;
+            case Op::call: return Opcode::call;
+            case Op::tail_call: return Opcode::tail_call;
+            case Op::native_call: return Opcode::native_call;
+            case Op::spawn: return Opcode::spawn;
             default: return {};
             }
         })(op);
@@ -459,4 +577,114 @@ namespace Minuet::Codegen {
 
         return true;
     }
+
+    /**
+     * @brief Rewrites `add / sub <temp> <x> <k>` followed by `mov <x> <temp>` into an in-place update of `x`, which is `inc / dec <x>` for a constant `k` of int `1` or else `add_assign / sub_assign <x> <k>`. The temp must have no other uses and the `mov` must not be a jump target.
+     */
+    void Emitter::lower_compound_assigns(Chunk& chunk, const std::vector<Runtime::FastValue>& constants) {
+        const auto [jump_target_ips, reg_use_counts] = scan_chunk_uses(chunk);
+        const int chunk_len = chunk.size();
+        std::vector<bool> marks (chunk_len, false);
+
+        for (auto ip = 0; ip + 1 < chunk_len; ++ip) {
+            auto& inst = chunk[ip];
+            const auto& next_inst = chunk[ip + 1];
+
+            if ((inst.op != Opcode::add && inst.op != Opcode::sub) || next_inst.op != Opcode::mov) {
+                continue;
+            }
+
+            const auto temp_reg = inst.args[0];
+            const auto target_reg = inst.args[1];
+            const auto step_arg = inst.args[2];
+            const auto step_mode = arg_mode_at(inst, 2);
+
+            if (arg_mode_at(inst, 1) != ArgMode::reg || arg_mode_at(next_inst, 0) != ArgMode::reg || arg_mode_at(next_inst, 1) != ArgMode::reg) {
+                continue;
+            }
+
+            if (next_inst.args[0] != target_reg || next_inst.args[1] != temp_reg || !reg_use_counts.contains(temp_reg) || reg_use_counts.at(temp_reg) != 2 || jump_target_ips.contains(ip + 1)) {
+                continue;
+            }
+
+            if (step_mode == ArgMode::reg && step_arg == temp_reg) {
+                continue;
+            }
+
+            const bool unit_step = step_mode == ArgMode::constant && constants.at(step_arg).tag() == Runtime::FVTag::int32 && constants.at(step_arg) == Runtime::FastValue {1};
+
+            if (unit_step) {
+                inst = Instruction {
+                    .args = {target_reg, 0, 0},
+                    .metadata = Utils::encode_metadata(Utils::PseudoArg {.value = target_reg, .tag = ArgMode::reg}),
+                    .op = (inst.op == Opcode::add) ? Opcode::inc : Opcode::dec,
+                };
+            } else {
+                inst = Instruction {
+                    .args = {target_reg, step_arg, 0},
+                    .metadata = Utils::encode_metadata(Utils::PseudoArg {.value = target_reg, .tag = ArgMode::reg}, Utils::PseudoArg {.value = step_arg, .tag = step_mode}),
+                    .op = (inst.op == Opcode::add) ? Opcode::add_assign : Opcode::sub_assign,
+                };
+            }
+
+            marks[ip + 1] = true;
+            ++ip;
+        }
+
+        erase_marked_instructions(chunk, marks);
+    }
+
+    /**
+     * @brief Replaces each compare & `jump_if / jump_else` pair with one compare-and-branch instruction, but only when the compare's temp register is used nowhere else in the chunk and no jump lands on the conditional jump itself.
+     */
+    void Emitter::fuse_compare_jumps(Chunk& chunk) {
+        const auto fused_opcode_of = [](Opcode compare_op, Opcode jump_op) noexcept -> std::optional<Opcode> {
+            const bool jump_on_truthy = jump_op == Opcode::jump_if;
+
+            if (jump_op != Opcode::jump_if && jump_op != Opcode::jump_else) {
+                return {};
+            }
+
+            /// NOTE: `!(a < b)` is not `a >= b` for mismatched operand types, so falsy jumps of ordering compares get their own negated opcodes.
+            switch (compare_op) {
+                case Opcode::equ: return (jump_on_truthy) ? Opcode::jeq : Opcode::jne;
+                case Opcode::neq: return (jump_on_truthy) ? Opcode::jne : Opcode::jeq;
+                case Opcode::lt: return (jump_on_truthy) ? Opcode::jlt : Opcode::jnlt;
+                case Opcode::gt: return (jump_on_truthy) ? Opcode::jgt : Opcode::jngt;
+                case Opcode::lte: return (jump_on_truthy) ? Opcode::jle : Opcode::jnle;
+                case Opcode::gte: return (jump_on_truthy) ? Opcode::jge : Opcode::jnge;
+                default: return {};
+            }
+        };
+
+        const auto [jump_target_ips, reg_use_counts] = scan_chunk_uses(chunk);
+        const int chunk_len = chunk.size();
+        std::vector<bool> marks (chunk_len, false);
+
+        for (auto ip = 0; ip + 1 < chunk_len; ++ip) {
+            auto& inst = chunk[ip];
+            const auto& next_inst = chunk[ip + 1];
+            const auto fused_op = fused_opcode_of(inst.op, next_inst.op);
+            const auto temp_reg = inst.args[0];
+
+            if (!fused_op || next_inst.args[0] != temp_reg || !reg_use_counts.contains(temp_reg) || reg_use_counts.at(temp_reg) != 2 || jump_target_ips.contains(ip + 1)) {
+                continue;
+            }
+
+            const auto lhs_mode = static_cast<uint16_t>(arg_mode_at(inst, 1));
+            const auto rhs_mode = static_cast<uint16_t>(arg_mode_at(inst, 2));
+            const auto target_mode = static_cast<uint16_t>(ArgMode::immediate);
+
+            inst = Instruction {
+                .args = {inst.args[1], inst.args[2], next_inst.args[1]},
+                .metadata = static_cast<uint16_t>(0b11 + (lhs_mode << 2) + (rhs_mode << 6) + (target_mode << 10)),
+                .op = fused_op.value(),
+            };
+
+            marks[ip + 1] = true;
+            ++ip;
+        }
+
+        erase_marked_instructions(chunk, marks);
+    }
 }
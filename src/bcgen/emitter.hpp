@@ -82,6 +82,9 @@ namespace Minuet::Codegen {
         [[nodiscard]] auto emit_bb(const IR::CFG::BasicBlock& bb) -> bool;
         [[nodiscard]] auto emit_chunk(const IR::CFG::CFG& cfg) -> bool;
 
+        void lower_compound_assigns(Runtime::Code::Chunk& chunk, const std::vector<Runtime::FastValue>& constants);
+        void fuse_compare_jumps(Runtime::Code::Chunk& chunk);
+
         std::vector<Runtime::Code::Chunk> m_result_chunks;
         std::vector<Utils::ActiveIfElse> m_active_ifs;
         std::vector<Utils::ActiveLoop> m_active_loops;
@@ -1,8 +1,12 @@
+#include <atomic>
 #include <set>
 #include <stack>
 #include <chrono>
 #include <memory>
+#include <format>
+#include <fstream>
 #include <iostream>
+#include <thread>
 
 #include "semantics/analyzer.hpp"
 #include "ir/convert_ast.hpp"
@@ -20,6 +24,7 @@ namespace Minuet::Driver {
     using IR::Convert::ASTConversion;
     using Runtime::VM::Utils::EngineConfig;
     using Runtime::VM::Utils::ExecStatus;
+    using Runtime::VM::Utils::FeedbackMode;
     using Runtime::NativeProcTable;
     using Runtime::NativeProcRegistry;
     using Plugins::IRDumper;
@@ -27,12 +32,71 @@ namespace Minuet::Driver {
     using Sources::read_source;
 
     static constexpr auto normal_vm_config = EngineConfig {
-        .reg_buffer_limit = 8192,
-        .call_frame_max = 512,
+        .reg_buffer_limit = 1 << 21,
+        .call_frame_max = 1 << 18,
+        .quicken_code = false,
+        .type_feedback = Runtime::VM::Utils::FeedbackMode::shared,
+        .slice_budget = 0,
+        .task_quantum = 2048,
+        .jit_threshold = 0,
+        .trace_threshold = 0,
+        .gc_max_pause = 0,
+        .gc_growth_percent = 200,
+        .gc_threads = 0,
     };
 
+    /// NOTE: Gives the upper bound in microseconds of the pause bucket holding the `fraction` quantile.
+    [[nodiscard]] auto gc_pause_quantile_us(const Runtime::VM::Utils::GCPauseStats& stats, double fraction) noexcept -> int64_t {
+        const auto rank = static_cast<int64_t>(fraction * static_cast<double>(stats.count));
+        int64_t seen_count = 0;
+
+        for (auto bucket_id = 0; bucket_id < Runtime::VM::Utils::GCPauseStats::bucket_count; ++bucket_id) {
+            seen_count += stats.buckets[bucket_id];
+
+            if (seen_count > rank) {
+                return int64_t {1} << bucket_id;
+            }
+        }
+
+        return int64_t {1} << (Runtime::VM::Utils::GCPauseStats::bucket_count - 1);
+    }
+
+    /// NOTE: sequences with the largest payloads which a heap report lists
+    static constexpr auto cm_heap_report_top = 5UL;
+
+    void print_heap_census(std::string_view title, const Runtime::HeapCensus& census) {
+        std::println("Heap census {}:", title);
+
+        for (auto tag_id = 0UL; tag_id < Runtime::object_tag_count; ++tag_id) {
+            if (const auto& [object_count, element_count, memory_score] = census.by_tag[tag_id]; object_count > 0) {
+                std::println("  {}: {} objects, {} elements, {} payload bytes", Runtime::object_tag_name(static_cast<Runtime::ObjectTag>(tag_id)), object_count, element_count, memory_score);
+            }
+        }
+
+        const auto hole_percent = census.hole_count * 100UL / std::max(census.slot_high_water, 1UL);
+
+        std::println("  young objects: {}, dead awaiting sweep: {}", census.young_count, census.dead_count);
+        std::println("  old slots: {} reached of {}, {} holes ({}%), longest hole run {}", census.slot_high_water, census.slot_capacity, census.hole_count, hole_percent, census.longest_hole_run);
+        std::println("  old bytes: {}, next full GC at {}", census.old_bytes, census.next_gc_bytes);
+        std::println("  object slabs: {} allocations, {} frees, {} bytes in use", census.object_slabs.allocations, census.object_slabs.frees, census.object_slabs.bytes_in_use);
+        std::println("  payload pool: {} allocations, {} frees, {} bytes in use", census.payload_pool.allocations, census.payload_pool.frees, census.payload_pool.bytes_in_use);
+
+        for (const auto& [object_id, element_count, memory_score, young] : census.largest_sequences) {
+            std::println("  sequence #{}{}: {} elements, {} payload bytes", object_id, (young) ? " (young)" : "", element_count, memory_score);
+        }
+
+        std::println();
+    }
+
+    /// NOTE: GC observer of `HeapReportMode::each_gc`, whose context counts the full collections so far.
+    void print_gc_census(const Runtime::HeapCensus& census, void* context) {
+        auto& gc_count = *static_cast<int*>(context);
+
+        print_heap_census(std::format("after full GC #{}", ++gc_count), census);
+    }
+
     Driver::Driver()
-    : m_lexer {}, m_src_map {}, m_native_procs {}, m_native_proc_ids {}, m_ir_printer {}, m_disassembler {} {
+    : m_lexer {}, m_src_map {}, m_native_procs {}, m_native_proc_ids {}, m_inlinable_natives {}, m_ir_printer {}, m_disassembler {}, m_vm_config {normal_vm_config}, m_heap_snapshot_path {}, m_heap_report {HeapReportMode::off}, m_job_count {1}, m_repeat_count {1} {
         m_lexer.add_lexical_item({.text = "true", .tag = TokenType::literal_true});
         m_lexer.add_lexical_item({.text = "false", .tag = TokenType::literal_false});
         m_lexer.add_lexical_item({.text = "fn", .tag = TokenType::keyword_fn});
@@ -48,6 +112,8 @@ namespace Minuet::Driver {
         m_lexer.add_lexical_item({.text = "return", .tag = TokenType::keyword_return});
         m_lexer.add_lexical_item({.text = "while", .tag = TokenType::keyword_while});
         m_lexer.add_lexical_item({.text = "break", .tag = TokenType::keyword_break});
+        m_lexer.add_lexical_item({.text = "spawn", .tag = TokenType::keyword_spawn});
+        m_lexer.add_lexical_item({.text = "yield", .tag = TokenType::keyword_yield});
         m_lexer.add_lexical_item({.text = "*", .tag = TokenType::oper_times});
         m_lexer.add_lexical_item({.text = "/", .tag = TokenType::oper_slash});
         m_lexer.add_lexical_item({.text = "%", .tag = TokenType::oper_modulo});
@@ -64,7 +130,7 @@ namespace Minuet::Driver {
     }
 
     auto Driver::register_native_proc(const Runtime::NativeProcItem& item) -> bool {
-        const auto& [native_fn_name, native_fn_ptr] = item;
+        const auto& [native_fn_name, native_fn_ptr, native_fn_inlinable] = item;
         const int next_native_fn_id = m_native_proc_ids.size();
         std::string key {native_fn_name.data()};
 
@@ -75,6 +141,10 @@ namespace Minuet::Driver {
         m_native_proc_ids[key] = next_native_fn_id;
         m_native_procs.emplace_back(native_fn_ptr);
 
+        if (native_fn_inlinable) {
+            m_inlinable_natives.emplace(key);
+        }
+
         return true;
     }
 
@@ -135,7 +205,7 @@ namespace Minuet::Driver {
     }
 
     auto Driver::generate_ir(const FullAST& ast) -> std::optional<FullIR> {
-        ASTConversion ir_generator {&m_native_proc_ids};
+        ASTConversion ir_generator {&m_native_proc_ids, &m_inlinable_natives};
 
         auto ir_opt = ir_generator(ast, m_src_map);
 
@@ -172,53 +242,150 @@ namespace Minuet::Driver {
         m_disassembler = std::make_unique<Disassembler>(bc_printer);
     }
 
-    auto Driver::operator()(const std::filesystem::path& entry_source_path) -> bool {
+    void Driver::set_quickening(bool enabled_flag) noexcept {
+        m_vm_config.quicken_code = enabled_flag;
+    }
+
+    void Driver::set_type_feedback(Runtime::VM::Utils::FeedbackMode mode) noexcept {
+        m_vm_config.type_feedback = mode;
+    }
+
+    void Driver::set_slice_budget(int budget) noexcept {
+        m_vm_config.slice_budget = budget;
+    }
+
+    void Driver::set_jit_threshold(int call_count) noexcept {
+        m_vm_config.jit_threshold = call_count;
+    }
+
+    void Driver::set_trace_threshold(int back_edge_count) noexcept {
+        m_vm_config.trace_threshold = back_edge_count;
+    }
+
+    void Driver::set_gc_max_pause(int pause_us) noexcept {
+        m_vm_config.gc_max_pause = pause_us;
+    }
+
+    void Driver::set_gc_growth(int growth_percent) noexcept {
+        m_vm_config.gc_growth_percent = growth_percent;
+    }
+
+    void Driver::set_gc_threads(int thread_count) noexcept {
+        m_vm_config.gc_threads = thread_count;
+    }
+
+    void Driver::set_job_counts(int jobs, int repeat) noexcept {
+        m_job_count = std::max(jobs, 1);
+        m_repeat_count = std::max(repeat, 1);
+    }
+
+    void Driver::set_heap_report(HeapReportMode mode) noexcept {
+        m_heap_report = mode;
+    }
+
+    void Driver::set_heap_snapshot(std::filesystem::path snapshot_path) {
+        m_heap_snapshot_path = std::move(snapshot_path);
+    }
+
+    auto Driver::compile(const std::filesystem::path& entry_source_path) -> std::optional<Runtime::Code::Program> {
         auto parsed_program = parse_sources(entry_source_path);
 
         if (!parsed_program) {
-            return false;
+            return {};
         }
 
         if (!check_semantics(parsed_program.value())) {
-            return false;
+            return {};
         }
 
         auto program_ir_opt = generate_ir(parsed_program.value());
 
         if (!program_ir_opt) {
-            return false;
+            return {};
         }
 
         auto& program_ir = program_ir_opt.value();
 
-        m_ir_printer->operator()(&program_ir);
+        if (m_ir_printer) {
+            m_ir_printer->operator()(&program_ir);
+        }
 
         if (!apply_ir_passes(program_ir)) {
-            return false;
+            return {};
         }
 
         auto program_opt = generate_program(program_ir);
 
+        if (!program_opt) {
+            return {};
+        }
+
+        if (m_disassembler) {
+            m_disassembler->operator()(&program_opt.value());
+        }
+
+        return program_opt;
+    }
+
+    /**
+     * @brief Creates an engine for a compiled program with this driver's VM config & natives. The program and driver must outlive the engine, which may then run `main` or serve many `Engine::invoke()` calls.
+     */
+    auto Driver::make_engine(Runtime::Code::Program& program) -> Runtime::VM::Engine {
+        return Runtime::VM::Engine {m_vm_config, program, &m_native_procs};
+    }
+
+    auto Driver::operator()(const std::filesystem::path& entry_source_path) -> bool {
+        auto program_opt = compile(entry_source_path);
+
         if (!program_opt) {
             return false;
         }
 
         auto& program = program_opt.value();
 
-        m_disassembler->operator()(&program);
-
-        if (!m_ir_printer->is_disabled() && !m_disassembler->is_disabled()) {
+        if (m_ir_printer && m_disassembler && !m_ir_printer->is_disabled() && !m_disassembler->is_disabled()) {
             return true;
         }
 
-        Runtime::VM::Engine vm {normal_vm_config, program, &m_native_procs};
+        if (m_job_count > 1 || m_repeat_count > 1) {
+            return run_jobs(program);
+        }
+
+        auto vm = make_engine(program);
+        int full_gc_count = 0;
+
+        if (m_heap_report == HeapReportMode::each_gc) {
+            vm.set_gc_observer(print_gc_census, &full_gc_count, cm_heap_report_top);
+        }
 
         auto run_start = std::chrono::steady_clock::now();
-        const auto exec_status = vm();
+        auto exec_status = vm();
+
+        /// NOTE: A suspended run is resumed right away here, but embedders may interleave other engines between slices.
+        while (exec_status == ExecStatus::suspended) {
+            exec_status = vm();
+        }
+
         auto run_end = std::chrono::steady_clock::now();
 
         std::println("Finished in: {}\n", std::chrono::duration_cast<std::chrono::milliseconds>(run_end - run_start));
 
+        if (const auto& gc_pauses = vm.gc_pause_stats(); (m_vm_config.gc_max_pause > 0 || m_vm_config.gc_threads > 0) && gc_pauses.count > 0) {
+            std::println("GC pauses: {}, p50 < {}us, p99 < {}us, max {}us, total {}us", gc_pauses.count, gc_pause_quantile_us(gc_pauses, 0.5), gc_pause_quantile_us(gc_pauses, 0.99), gc_pauses.max_ns / 1000, gc_pauses.total_ns / 1000);
+            std::println("Full GCs: {} in {} steps ({} parallel), max step {}us\n", gc_pauses.full_collections, gc_pauses.full_steps, gc_pauses.parallel_steps, gc_pauses.full_step_max_ns / 1000);
+        }
+
+        /// NOTE: Once `main` has returned, no frame roots are left, so both reports cover every resident object including garbage which no full collection has freed yet.
+        if (m_heap_report != HeapReportMode::off) {
+            print_heap_census("of resident objects at exit", vm.heap_census(cm_heap_report_top));
+        }
+
+        if (!m_heap_snapshot_path.empty()) {
+            if (std::ofstream snapshot_out {m_heap_snapshot_path, std::ios::binary}; !snapshot_out || !vm.write_heap_snapshot(snapshot_out)) {
+                std::println(std::cerr, "\033[1;31mFailed to write heap snapshot '{}'.\033[0m\n", m_heap_snapshot_path.string());
+            }
+        }
+
         switch (exec_status) {
             case ExecStatus::ok:
                 std::println("\033[1;32mStatus OK\033[0m\n");
@@ -228,4 +395,68 @@ namespace Minuet::Driver {
                 return false;
         }
     }
+
+    /**
+     * @brief Runs `main` repeatedly on several threads, then reports the throughput. Every thread owns one warm engine with its own heap & registers, but the program and native table are shared. So, the program is quickened once up front and type feedback is kept private to each engine, leaving the shared program read-only.
+     */
+    auto Driver::run_jobs(Runtime::Code::Program& program) -> bool {
+        auto job_config = m_vm_config;
+
+        if (job_config.quicken_code) {
+            Runtime::Code::quicken_program(program);
+            job_config.quicken_code = false;
+        }
+
+        if (job_config.type_feedback == FeedbackMode::shared) {
+            job_config.type_feedback = FeedbackMode::isolated;
+        }
+
+        const auto entry_id = static_cast<int16_t>(program.entry_id.value_or(-1));
+        std::atomic<int> failed_runs {0};
+        std::atomic<int> last_bad_status {static_cast<int>(ExecStatus::ok)};
+
+        auto run_start = std::chrono::steady_clock::now();
+
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(m_job_count);
+
+            for (auto job_id = 0; job_id < m_job_count; ++job_id) {
+                workers.emplace_back([&, this]() {
+                    Runtime::VM::Engine vm {job_config, program, &m_native_procs};
+
+                    for (auto run_id = 0; run_id < m_repeat_count; ++run_id) {
+                        auto run_result = vm.invoke(entry_id, {});
+
+                        while (run_result.status == ExecStatus::suspended) {
+                            run_result = vm.resume();
+                        }
+
+                        if (run_result.status != ExecStatus::ok) {
+                            last_bad_status = static_cast<int>(run_result.status);
+                            ++failed_runs;
+                        } else if (!(run_result.value == Runtime::FastValue {0})) {
+                            last_bad_status = static_cast<int>(ExecStatus::user_error);
+                            ++failed_runs;
+                        }
+                    }
+                });
+            }
+        }
+
+        auto run_end = std::chrono::steady_clock::now();
+
+        const auto total_runs = m_job_count * m_repeat_count;
+        const auto run_secs = std::chrono::duration<double>(run_end - run_start).count();
+
+        std::println("Finished {} runs on {} jobs in: {}, {:.1f} runs/s\n", total_runs, m_job_count, std::chrono::duration_cast<std::chrono::milliseconds>(run_end - run_start), total_runs / std::max(run_secs, 1e-9));
+
+        if (failed_runs > 0) {
+            std::println(std::cerr, "\033[1;31mRuntime Error: {} of {} runs failed, last with ExecStatus #{}, see vm.md for details.\033[0m\n", failed_runs.load(), total_runs, last_bad_status.load());
+            return false;
+        }
+
+        std::println("\033[1;32mStatus OK\033[0m\n");
+        return true;
+    }
 }
@@ -8,11 +8,19 @@
 #include "ir/cfg.hpp"
 #include "runtime/bytecode.hpp"
 #include "runtime/natives.hpp"
+#include "runtime/vm.hpp"
 #include "driver/plugins/printer.hpp"
 #include "driver/plugins/ir_dumper.hpp"
 #include "driver/plugins/disassembler.hpp"
 
 namespace Minuet::Driver {
+    /// NOTE: When a run prints censuses of its heap.
+    enum class HeapReportMode : uint8_t {
+        off,
+        at_exit,
+        each_gc, // after every full collection & at exit
+    };
+
     class Driver {
     public:
         Driver();
@@ -30,18 +38,42 @@ namespace Minuet::Driver {
 
         [[maybe_unused]] auto generate_program(IR::CFG::FullIR& ir) -> std::optional<Runtime::Code::Program>;
 
+        /// NOTE: Runs the whole pipeline from sources to a program without running it.
+        [[nodiscard]] auto compile(const std::filesystem::path& entry_source_path) -> std::optional<Runtime::Code::Program>;
+
+        [[nodiscard]] auto make_engine(Runtime::Code::Program& program) -> Runtime::VM::Engine;
+
         [[nodiscard]] auto operator()(const std::filesystem::path& entry_source_path) -> bool;
 
         void add_ir_dumper(Plugins::IRDumper ir_printer) noexcept;
         void add_disassembler(Plugins::Disassembler bc_printer) noexcept;
+        void set_quickening(bool enabled_flag) noexcept;
+        void set_type_feedback(Runtime::VM::Utils::FeedbackMode mode) noexcept;
+        void set_slice_budget(int budget) noexcept;
+        void set_jit_threshold(int call_count) noexcept;
+        void set_trace_threshold(int back_edge_count) noexcept;
+        void set_gc_max_pause(int pause_us) noexcept;
+        void set_gc_growth(int growth_percent) noexcept;
+        void set_gc_threads(int thread_count) noexcept;
+        void set_job_counts(int jobs, int repeat) noexcept;
+        void set_heap_report(HeapReportMode mode) noexcept;
+        void set_heap_snapshot(std::filesystem::path snapshot_path);
 
     private:
+        [[nodiscard]] auto run_jobs(Runtime::Code::Program& program) -> bool;
+
         Frontend::Lexing::Lexer m_lexer;
         std::unordered_map<uint32_t, std::string> m_src_map;
         Runtime::NativeProcTable m_native_procs;
         Runtime::NativeProcRegistry m_native_proc_ids;
+        Runtime::NativeInlineNames m_inlinable_natives;
         std::unique_ptr<Plugins::Printer> m_ir_printer;
         std::unique_ptr<Plugins::Printer> m_disassembler;
+        Runtime::VM::Utils::EngineConfig m_vm_config;
+        std::filesystem::path m_heap_snapshot_path;
+        HeapReportMode m_heap_report;
+        int m_job_count;
+        int m_repeat_count;
     };
 }
 
@@ -115,7 +115,7 @@ namespace Minuet::Driver::Plugins {
     }
 
     void IRDumper::print_ir(const FullIR& full_ir) const {
-        const auto& [ir_cfgs, ir_constants, entry_id] = full_ir;
+        const auto& [ir_cfgs, ir_constants, ir_function_ids, entry_id] = full_ir;
 
         std::println("\n\033[1;33mComplete IR:\033[0m\n");
         std::println("\033[1;33mConstants:\033[0m\n");
@@ -22,6 +22,8 @@ namespace Minuet::Frontend::Lexicals {
         keyword_return,
         keyword_while,
         keyword_break,
+        keyword_spawn,
+        keyword_yield,
         identifier,
         literal_false,
         literal_true,
@@ -565,6 +565,28 @@ namespace Minuet::Frontend::Parsing {
         return std::make_unique<Stmt>(Syntax::Stmts::Break {});
     }
 
+    auto Parser::parse_spawn(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr {
+        const auto stmt_begin = m_current.start;
+        consume(lexer, src, TokenType::keyword_spawn);
+
+        auto call_expr = parse_call(lexer, src);
+        const auto stmt_end = m_current.start;
+
+        return std::make_unique<Stmt>(Stmt {
+            .data = Syntax::Stmts::Spawn {
+                .call = std::move(call_expr),
+            },
+            .src_begin = stmt_begin,
+            .src_end = stmt_end,
+        });
+    }
+
+    auto Parser::parse_yield(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr {
+        consume(lexer, src, TokenType::keyword_yield);
+
+        return std::make_unique<Stmt>(Syntax::Stmts::Yield {});
+    }
+
     // auto Parser::parse_match_case(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
     // auto Parser::parse_match(Lexing::Lexer& lexer, std::string_view src) -> Syntax::Stmts::StmtPtr;
 
@@ -593,6 +615,10 @@ namespace Minuet::Frontend::Parsing {
                     return parse_while(lexer, src);
                 case TokenType::keyword_break:
                     return parse_break(lexer, src);
+                case TokenType::keyword_spawn:
+                    return parse_spawn(lexer, src);
+                case TokenType::keyword_yield:
+                    return parse_yield(lexer, src);
                 default:
                     return parse_expr_stmt(lexer, src);
                 }
@@ -2,6 +2,8 @@
 #define MINUET_IR_CFG_HPP
 
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/steps.hpp"
@@ -20,6 +22,7 @@ namespace Minuet::IR::CFG {
 
     private:
         std::vector<BasicBlock> m_blocks;
+        int16_t m_param_count;
 
     public:
         CFG();
@@ -36,6 +39,9 @@ namespace Minuet::IR::CFG {
         [[maybe_unused]] auto add_bb() & -> int;
         [[nodiscard]] bool link_bb(int from_id, int to_id) & noexcept;
 
+        [[nodiscard]] auto param_count() const& noexcept -> int16_t;
+        void set_param_count(int16_t count) & noexcept;
+
         template <template<typename> typename Pass, typename Result>
         [[nodiscard]] auto take_pass(this auto&& self, Pass<Result>& cfg_pass) noexcept(noexcept(cfg_pass.apply(self))) -> Result {
             return cfg_pass.apply(self);
@@ -45,6 +51,7 @@ namespace Minuet::IR::CFG {
     struct FullIR {
         std::vector<CFG> cfg_list;
         std::vector<Runtime::FastValue> constants;
+        std::unordered_map<std::string, int16_t> function_ids;
         int main_id;
     };
 }
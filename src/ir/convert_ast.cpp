@@ -1,4 +1,5 @@
 #include <utility>
+#include <algorithm>
 #include <iostream>
 #include <print>
 #include <variant>
@@ -26,9 +27,10 @@ namespace Minuet::IR::Convert {
     using Steps::OperTernary;
     using IR::CFG::FullIR;
     using Utils::NameLocation;
+    using Utils::InlinedNative;
 
-    ASTConversion::ASTConversion(const Runtime::NativeProcRegistry* native_proc_ids)
-    : m_globals {}, m_locals {}, m_pending_links {}, m_result_cfgs {}, m_proto_consts {}, m_native_proc_ids {native_proc_ids}, m_proto_main_id {-1}, m_error_count {0}, m_next_func_aa {0}, m_next_local_aa {0}, m_prepassing {true} {}
+    ASTConversion::ASTConversion(const Runtime::NativeProcRegistry* native_proc_ids, const Runtime::NativeInlineNames* inlinable_natives)
+    : m_globals {}, m_locals {}, m_pending_links {}, m_result_cfgs {}, m_proto_consts {}, m_proto_func_ids {}, m_native_proc_ids {native_proc_ids}, m_inlinable_natives {inlinable_natives}, m_proto_main_id {-1}, m_error_count {0}, m_next_func_aa {0}, m_next_local_aa {0}, m_prepassing {true} {}
 
     auto ASTConversion::operator()(const Syntax::AST::FullAST& src_mapped_ast, const std::unordered_map<uint32_t, std::string>& source_map) -> std::optional<FullIR> {
         // 1. Prepass top-level definitions of functions, etc. to avoid forward declaration jank.
@@ -54,6 +56,7 @@ namespace Minuet::IR::Convert {
         return FullIR {
             .cfg_list = std::exchange(m_result_cfgs, {}),
             .constants = std::exchange(m_proto_consts, {}),
+            .function_ids = std::exchange(m_proto_func_ids, {}),
             .main_id = m_proto_main_id,
         };
     }
@@ -345,44 +348,183 @@ namespace Minuet::IR::Convert {
         return bin_result_aa;
     }
 
-    auto ASTConversion::emit_call(const Syntax::Exprs::Call& call, std::string_view source) -> std::optional<AbsAddress> {
+    /**
+     * @brief Checks if a call targets a builtin native which lowers to VM opcodes. The native was registered as `inlinable`, isn't shadowed by any user-defined name, and gets its usual argument count. Otherwise, the call stays a `native_call`.
+     */
+    auto ASTConversion::lookup_inlined_native(const Syntax::Exprs::Call& call, std::string_view source) -> std::optional<InlinedNative> {
+        const auto callee_literal_p = std::get_if<Syntax::Exprs::Literal>(&call.callee->data);
+
+        if (callee_literal_p == nullptr || callee_literal_p->token.type != TokenType::identifier) {
+            return {};
+        }
+
+        std::string callee_name = std::format("{}", token_to_sv(callee_literal_p->token, source));
+
+        if (m_inlinable_natives == nullptr || !m_inlinable_natives->contains(callee_name) || m_locals.contains(callee_name) || m_globals.contains(callee_name)) {
+            return {};
+        }
+
+        const auto args_n = call.args.size();
+
+        if (callee_name == "len_of" && args_n == 1) {
+            return InlinedNative::len_of;
+        } else if (callee_name == "list_push_back" && args_n == 2) {
+            return InlinedNative::list_push_back;
+        } else if (callee_name == "list_pop_back" && args_n == 1) {
+            return InlinedNative::list_pop_back;
+        } else if (callee_name == "list_pop_front" && args_n == 1) {
+            return InlinedNative::list_pop_front;
+        }
+
+        return {};
+    }
+
+    auto ASTConversion::emit_inlined_native(InlinedNative which, const Syntax::Exprs::Call& call, std::string_view source) -> std::optional<AbsAddress> {
+        auto target_aa_opt = emit_expr(call.args.front(), source);
+
+        if (!target_aa_opt) {
+            return {};
+        }
+
+        auto target_aa = target_aa_opt.value();
+
+        /// NOTE: The sequence opcodes only take their object in a register, so a constant argument is moved into a temp first.
+        if (target_aa.tag != AbsAddrTag::temp) {
+            auto target_temp_aa_opt = gen_temp_aa();
+
+            if (!target_temp_aa_opt) {
+                return {};
+            }
+
+            m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(TACUnary {
+                .dest = target_temp_aa_opt.value(),
+                .arg_0 = target_aa,
+                .op = Op::nop,
+            });
+
+            target_aa = target_temp_aa_opt.value();
+        }
+
+        if (which == InlinedNative::list_push_back) {
+            auto item_aa_opt = emit_expr(call.args.back(), source);
+
+            if (!item_aa_opt) {
+                return {};
+            }
+
+            m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperTernary {
+                .arg_0 = target_aa,
+                .arg_1 = item_aa_opt.value(),
+                .arg_2 = {
+                    .id = static_cast<int16_t>(Runtime::SequenceOpPolicy::back),
+                    .tag = AbsAddrTag::immediate,
+                },
+                .op = Op::seq_obj_push,
+            });
+
+            return target_aa;
+        }
+
+        auto result_aa_opt = gen_temp_aa();
+
+        if (!result_aa_opt) {
+            return {};
+        }
+
+        auto result_aa = result_aa_opt.value();
+
+        if (which == InlinedNative::len_of) {
+            m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(TACUnary {
+                .dest = result_aa,
+                .arg_0 = target_aa,
+                .op = Op::seq_len,
+            });
+        } else {
+            const auto pop_mode = (which == InlinedNative::list_pop_back)
+                ? Runtime::SequenceOpPolicy::back
+                : Runtime::SequenceOpPolicy::front;
+
+            m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperTernary {
+                .arg_0 = result_aa,
+                .arg_1 = target_aa,
+                .arg_2 = {
+                    .id = static_cast<int16_t>(pop_mode),
+                    .tag = AbsAddrTag::immediate,
+                },
+                .op = Op::seq_obj_pop,
+            });
+        }
+
+        return result_aa;
+    }
+
+    auto ASTConversion::emit_call(const Syntax::Exprs::Call& call, std::string_view source, Utils::CallMode mode) -> std::optional<AbsAddress> {
+        if (mode != Utils::CallMode::spawn) {
+            if (auto inlined_native_opt = lookup_inlined_native(call, source); inlined_native_opt) {
+                return emit_inlined_native(inlined_native_opt.value(), call, source);
+            }
+        }
+
         auto callee_aa_opt = emit_expr(call.callee, source);
 
         if (!callee_aa_opt) {
             return {};
         }
 
+        /// NOTE: A green thread runs bytecode only, since a native call would block every other task anyways.
+        if (mode == Utils::CallMode::spawn && callee_aa_opt->tag != AbsAddrTag::immediate) {
+            report_error("Only Minuet functions can be spawned, not natives.");
+            return {};
+        }
+
         /// NOTE: Any call will take the function ID and then N (stack argument count).
         const int16_t real_args_n = call.args.size();
+        std::vector<AbsAddress> arg_aas;
 
+        /// NOTE: All arguments are evaluated before any is placed, so that their temps stay contiguous at the top of the frame for the callee even when an argument needs temps of its own.
         for (int16_t arg_idx = 0; arg_idx < real_args_n; ++arg_idx) {
             if (auto arg_aa_opt = emit_expr(call.args.at(arg_idx), source); arg_aa_opt) {
-                if (auto arg_dest_aa = gen_temp_aa(); arg_dest_aa) {
-                    m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(TACUnary {
-                        .dest = arg_dest_aa.value(),
-                        .arg_0 = arg_aa_opt.value(),
-                        .op = Op::nop,
-                    });
-                }
-
+                arg_aas.emplace_back(arg_aa_opt.value());
                 continue;
             }
 
             return {};
         }
 
+        for (const auto& arg_aa : arg_aas) {
+            if (auto arg_dest_aa = gen_temp_aa(); arg_dest_aa) {
+                m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(TACUnary {
+                    .dest = arg_dest_aa.value(),
+                    .arg_0 = arg_aa,
+                    .op = Op::nop,
+                });
+            }
+        }
+
+        /// NOTE: A call without arguments still needs its own temp for the result.
+        if (real_args_n == 0 && !gen_temp_aa()) {
+            return {};
+        }
+
         const auto call_result_slot_aa = AbsAddress {
-            .id = static_cast<int16_t>(m_next_local_aa - real_args_n),
+            .id = static_cast<int16_t>(m_next_local_aa - std::max<int16_t>(real_args_n, 1)),
             .tag = AbsAddrTag::temp,
         };
 
         auto callee_aa = callee_aa_opt.value();
-        /// NOTE: the IR `Op` for call expressions will be `native_call` upon an AbsAddress with reused tag `constant`... This denotes a function pointer ID from the native procedure "registry".
-        const auto calling_op = (callee_aa.tag == AbsAddrTag::immediate)
-            ? Op::call
-            : Op::native_call;
+        /// NOTE: the IR `Op` for call expressions will be `native_call` upon an AbsAddress with reused tag `constant`... This denotes a function pointer ID from the native procedure "registry". Only bytecode function calls in tail position can reuse the caller's frame.
+        auto calling_op = Op::native_call;
+
+        if (callee_aa.tag == AbsAddrTag::immediate) {
+            switch (mode) {
+                case Utils::CallMode::tail: calling_op = Op::tail_call; break;
+                case Utils::CallMode::spawn: calling_op = Op::spawn; break;
+                default: calling_op = Op::call; break;
+            }
+        }
 
-        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperBinary {
+        /// NOTE: The 3rd operand is the first argument's temp, which becomes the callee's frame base & result slot.
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperTernary {
             .arg_0 = {
                 .id = callee_aa.id,
                 .tag = AbsAddrTag::immediate,
@@ -391,6 +533,7 @@ namespace Minuet::IR::Convert {
                 .id = real_args_n,
                 .tag = AbsAddrTag::immediate,
             },
+            .arg_2 = call_result_slot_aa,
             .op = calling_op,
         });
 
@@ -583,12 +726,24 @@ namespace Minuet::IR::Convert {
     }
 
     auto ASTConversion::emit_return(const Syntax::Stmts::Return& ret, std::string_view source) -> bool {
-        auto result_aa_opt = emit_expr(ret.result, source);
+        const auto tail_call_p = std::get_if<Syntax::Exprs::Call>(&ret.result->data);
+        auto result_aa_opt = (tail_call_p != nullptr)
+            ? emit_call(*tail_call_p, source, Utils::CallMode::tail)
+            : emit_expr(ret.result, source);
 
         if (!result_aa_opt) {
             return false;
         }
 
+        /// NOTE: A `tail_call` never comes back to this frame since its callee returns straight to our caller, so no `ret` is needed after it.
+        if (tail_call_p != nullptr) {
+            const auto& last_step = m_result_cfgs.back().get_newest_bb().value()->steps.back();
+
+            if (const auto last_oper_p = std::get_if<OperTernary>(&last_step); last_oper_p != nullptr && last_oper_p->op == Op::tail_call) {
+                return true;
+            }
+        }
+
         m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperUnary {
             .arg_0 = result_aa_opt.value(),
             .op = Op::ret,
@@ -702,6 +857,26 @@ namespace Minuet::IR::Convert {
         return true;
     }
 
+    auto ASTConversion::emit_spawn(const Syntax::Stmts::Spawn& spawn, std::string_view source) -> bool {
+        const auto call_p = std::get_if<Syntax::Exprs::Call>(&spawn.call->data);
+
+        if (call_p == nullptr) {
+            report_error("Only function calls can be spawned.");
+            return false;
+        }
+
+        /// NOTE: The spawned task's result is discarded, so its temp is only a copy of the arguments' base.
+        return emit_call(*call_p, source, Utils::CallMode::spawn).has_value();
+    }
+
+    auto ASTConversion::emit_yield([[maybe_unused]] const Syntax::Stmts::Yield& yield, [[maybe_unused]] std::string_view source) -> bool {
+        m_result_cfgs.back().get_newest_bb().value()->steps.emplace_back(OperNonary {
+            .op = Op::yield,
+        });
+
+        return true;
+    }
+
     auto ASTConversion::emit_block(const Syntax::Stmts::Block& block, std::string_view source) -> int {
         auto bb_id = m_result_cfgs.back().add_bb();
 
@@ -729,10 +904,13 @@ namespace Minuet::IR::Convert {
                 m_proto_main_id = func_aa.id;
             }
 
+            m_proto_func_ids.try_emplace(func_name, func_aa.id);
+
             return record_name_aa(NameLocation::global_function_slot, func_name, func_aa);
         }
 
         add_cfg();
+        m_result_cfgs.back().set_param_count(static_cast<int16_t>(fun.params.size()));
 
         auto generation_ok = true;
 
@@ -778,6 +956,10 @@ namespace Minuet::IR::Convert {
             return emit_while(*wloop_p, source);
         } else if (auto loop_brk_p = std::get_if<Break>(&stmt->data); loop_brk_p) {
             return emit_break(*loop_brk_p, source);
+        } else if (auto spawn_p = std::get_if<Spawn>(&stmt->data); spawn_p) {
+            return emit_spawn(*spawn_p, source);
+        } else if (auto yield_p = std::get_if<Yield>(&stmt->data); yield_p) {
+            return emit_yield(*yield_p, source);
         } else if (auto if_p = std::get_if<If>(&stmt->data); if_p) {
             return emit_if(*if_p, source);
         } else if (auto def_p = std::get_if<LocalDef>(&stmt->data); def_p) {
@@ -27,13 +27,28 @@ namespace Minuet::IR::Convert {
             global_function_slot,
             local_slot,
         };
+
+        /// NOTE: Builtin natives whose calls lower to VM opcodes instead of `native_call`.
+        enum class InlinedNative : uint8_t {
+            len_of,         // seq_len
+            list_push_back, // seq_obj_push
+            list_pop_back,  // seq_obj_pop
+            list_pop_front, // seq_obj_pop
+        };
+
+        /// NOTE: How a call's callee gets its frame: on top of the caller's, in place of the caller's, or as a new green thread.
+        enum class CallMode : uint8_t {
+            normal, // call
+            tail,   // tail_call
+            spawn,  // spawn
+        };
     }
 
 
     /// TODO: implement `emit_while()` method for generating CFG IR for while loops... there should be a jump_else to exit the loop & a jump back to the "check".
     class ASTConversion {
     public:
-        ASTConversion(const Runtime::NativeProcRegistry* native_proc_ids);
+        ASTConversion(const Runtime::NativeProcRegistry* native_proc_ids, const Runtime::NativeInlineNames* inlinable_natives);
 
         [[nodiscard]] auto operator()(const Syntax::AST::FullAST& src_mapped_ast, const std::unordered_map<uint32_t, std::string>& source_map) -> std::optional<CFG::FullIR>;
 
@@ -54,7 +69,9 @@ namespace Minuet::IR::Convert {
         [[nodiscard]] auto emit_sequence(const Syntax::Exprs::Sequence& sequence, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_unary(const Syntax::Exprs::Unary& unary, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_binary(const Syntax::Exprs::Binary& binary, std::string_view source) -> std::optional<Steps::AbsAddress>;
-        [[nodiscard]] auto emit_call(const Syntax::Exprs::Call& call, std::string_view source) -> std::optional<Steps::AbsAddress>;
+        [[nodiscard]] auto lookup_inlined_native(const Syntax::Exprs::Call& call, std::string_view source) -> std::optional<Utils::InlinedNative>;
+        [[nodiscard]] auto emit_inlined_native(Utils::InlinedNative which, const Syntax::Exprs::Call& call, std::string_view source) -> std::optional<Steps::AbsAddress>;
+        [[nodiscard]] auto emit_call(const Syntax::Exprs::Call& call, std::string_view source, Utils::CallMode mode = Utils::CallMode::normal) -> std::optional<Steps::AbsAddress>;
         [[nodiscard]] auto emit_assign(const Syntax::Exprs::Assign& assign, std::string_view source) -> std::optional<Steps::AbsAddress>;
         [[maybe_unused]] auto emit_expr(const Syntax::Exprs::ExprPtr& expr, std::string_view source) -> std::optional<Steps::AbsAddress>;
 
@@ -64,6 +81,8 @@ namespace Minuet::IR::Convert {
         [[nodiscard]] auto emit_return(const Syntax::Stmts::Return& ret, std::string_view source) -> bool;
         [[nodiscard]] auto emit_while(const Syntax::Stmts::While& wloop, std::string_view source) -> bool;
         [[nodiscard]] auto emit_break(const Syntax::Stmts::Break& loop_brk, std::string_view source) -> bool;
+        [[nodiscard]] auto emit_spawn(const Syntax::Stmts::Spawn& spawn, std::string_view source) -> bool;
+        [[nodiscard]] auto emit_yield(const Syntax::Stmts::Yield& yield, std::string_view source) -> bool;
         [[nodiscard]] auto emit_block(const Syntax::Stmts::Block& block, std::string_view source) -> int;
         [[nodiscard]] auto emit_function(const Syntax::Stmts::Function& fun, std::string_view source) -> bool;
         [[nodiscard]] auto emit_stmt(const Syntax::Stmts::StmtPtr& stmt, std::string_view source) -> bool;
@@ -73,7 +92,9 @@ namespace Minuet::IR::Convert {
         std::queue<Utils::BBLink> m_pending_links;
         std::vector<CFG::CFG> m_result_cfgs;
         std::vector<Runtime::FastValue> m_proto_consts;
+        std::unordered_map<std::string, int16_t> m_proto_func_ids;
         const Runtime::NativeProcRegistry* m_native_proc_ids;
+        const Runtime::NativeInlineNames* m_inlinable_natives;
         int m_proto_main_id;
         int m_error_count;
         int16_t m_next_func_aa;
@@ -10,6 +10,7 @@ namespace Minuet::IR::Steps {
         "seq_obj_pop",
         "seq_obj_get",
         "frz_seq_obj",
+        "seq_len",
         "neg",
         "inc",
         "dec",
@@ -28,7 +29,10 @@ namespace Minuet::IR::Steps {
         "jump_if",
         "jump_else",
         "call",
+        "tail_call",
         "native_call",
+        "spawn",
+        "yield",
         "ret",
         "halt",
         "#begin_while",
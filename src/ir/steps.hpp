@@ -13,6 +13,7 @@ namespace Minuet::IR::Steps {
         seq_obj_pop,
         seq_obj_get,
         frz_seq_obj,
+        seq_len,
         neg,
         inc,
         dec,
@@ -31,7 +32,10 @@ namespace Minuet::IR::Steps {
         jump_if,
         jump_else,
         call,
+        tail_call,
         native_call,
+        spawn,
+        yield,
         ret,
         halt,
         meta_begin_while,
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <print>
 
 #include "mintrinsics/mnl_stdio.hpp"
@@ -14,15 +19,43 @@ constexpr auto minuet_version_patch = 2;
 
 using namespace Minuet;
 
+void print_usage() {
+    std::println("minuetm v{}.{}.{}\n\nUsage: ./minuetm [info | compile-only <main-file> | run <main-file> [options...]]\n\tinfo []: shows usage info and version.\n\trun options:\n\t\t--quicken: rewrites bytecode into operand-specialized opcodes before running.\n\t\t--no-feedback: disables int32 specialization of arithmetic sites from type feedback.\n\t\t--slice <n>: suspends & resumes the VM after about n instructions of loops and calls.\n\t\t--jit <n>: compiles a function to x86-64 code once it has been called n times.\n\t\t--trace <n>: records a loop into a type-specialized trace once it has repeated n times.\n\t\t--gc-pause <us>: splits full GCs into steps of about us microseconds, then reports the GC pauses.\n\t\t--gc-growth <percent>: starts the next full GC once the old generation grows to this percentage of what survived the last one (default 200).\n\t\t--gc-threads <n>: shares stop-the-world GC marking & sweeping of large heaps among n threads, then reports the GC pauses.\n\t\t--heap-report: prints a census of the objects still resident at exit, element counts, payloads, and slot fragmentation.\n\t\t--heap-report-gc: prints the heap census after every full GC too.\n\t\t--heap-snapshot <file>: writes the graph of objects still resident at exit into file, without roots, in the binary layout of heap_census.hpp.\n\t\t--jobs <n>: runs main on n threads, each with its own VM, then reports throughput.\n\t\t--repeat <n>: runs main n times per job.", minuet_version_major, minuet_version_minor, minuet_version_patch);
+}
+
+/// NOTE: Parses a whole decimal count option which is at least `min_value`.
+[[nodiscard]] auto parse_count_option(std::string_view text, int min_value) -> std::optional<int> {
+    int count = 0;
+    const auto [count_end, count_errc] = std::from_chars(text.data(), text.data() + text.size(), count);
+
+    if (count_errc != std::errc {} || count_end != text.data() + text.size() || count < min_value) {
+        return {};
+    }
+
+    return count;
+}
+
 
 class DriverBuilder {
 private:
     bool m_ir_printer_on;
     bool m_bc_printer_on;
+    bool m_quicken_on;
+    bool m_feedback_on;
+    int m_slice_budget;
+    int m_jit_threshold;
+    int m_trace_threshold;
+    int m_gc_max_pause;
+    int m_gc_growth_percent;
+    int m_gc_threads;
+    Driver::HeapReportMode m_heap_report;
+    std::string m_heap_snapshot_path;
+    int m_job_count;
+    int m_repeat_count;
 
 public:
     DriverBuilder() noexcept
-    : m_ir_printer_on {false}, m_bc_printer_on {false} {}
+    : m_ir_printer_on {false}, m_bc_printer_on {false}, m_quicken_on {false}, m_feedback_on {true}, m_slice_budget {0}, m_jit_threshold {0}, m_trace_threshold {0}, m_gc_max_pause {0}, m_gc_growth_percent {200}, m_gc_threads {0}, m_heap_report {Driver::HeapReportMode::off}, m_heap_snapshot_path {}, m_job_count {1}, m_repeat_count {1} {}
 
     [[nodiscard]] auto config_ir_dumper(bool enabled_flag) noexcept -> DriverBuilder* {
         m_ir_printer_on = enabled_flag;
@@ -36,6 +69,73 @@ public:
         return this;
     }
 
+    [[nodiscard]] auto config_quickening(bool enabled_flag) noexcept -> DriverBuilder* {
+        m_quicken_on = enabled_flag;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_type_feedback(bool enabled_flag) noexcept -> DriverBuilder* {
+        m_feedback_on = enabled_flag;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_slice_budget(int budget) noexcept -> DriverBuilder* {
+        m_slice_budget = budget;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_jit(int call_count) noexcept -> DriverBuilder* {
+        m_jit_threshold = call_count;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_trace(int back_edge_count) noexcept -> DriverBuilder* {
+        m_trace_threshold = back_edge_count;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_gc_pause(int pause_us) noexcept -> DriverBuilder* {
+        m_gc_max_pause = pause_us;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_gc_growth(int growth_percent) noexcept -> DriverBuilder* {
+        m_gc_growth_percent = growth_percent;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_gc_threads(int thread_count) noexcept -> DriverBuilder* {
+        m_gc_threads = thread_count;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_heap_report(Driver::HeapReportMode mode) noexcept -> DriverBuilder* {
+        m_heap_report = mode;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_heap_snapshot(std::string_view snapshot_path) -> DriverBuilder* {
+        m_heap_snapshot_path = snapshot_path;
+
+        return this;
+    }
+
+    [[nodiscard]] auto config_jobs(int jobs, int repeat) noexcept -> DriverBuilder* {
+        m_job_count = jobs;
+        m_repeat_count = repeat;
+
+        return this;
+    }
+
     [[nodiscard]] auto build() noexcept -> Driver::Driver {
         Driver::Driver interpreter_driver;
 
@@ -46,6 +146,21 @@ public:
 
         interpreter_driver.add_ir_dumper(ir_printer);
         interpreter_driver.add_disassembler(bc_printer);
+        interpreter_driver.set_quickening(m_quicken_on);
+        interpreter_driver.set_type_feedback(
+            (m_feedback_on)
+                ? Runtime::VM::Utils::FeedbackMode::shared
+                : Runtime::VM::Utils::FeedbackMode::off
+        );
+        interpreter_driver.set_slice_budget(m_slice_budget);
+        interpreter_driver.set_jit_threshold(m_jit_threshold);
+        interpreter_driver.set_trace_threshold(m_trace_threshold);
+        interpreter_driver.set_gc_max_pause(m_gc_max_pause);
+        interpreter_driver.set_gc_growth(m_gc_growth_percent);
+        interpreter_driver.set_gc_threads(m_gc_threads);
+        interpreter_driver.set_heap_report(m_heap_report);
+        interpreter_driver.set_heap_snapshot(m_heap_snapshot_path);
+        interpreter_driver.set_job_counts(m_job_count, m_repeat_count);
 
         return interpreter_driver;
     }
@@ -64,16 +179,113 @@ int main(int argc, char* argv[]) {
     DriverBuilder driver_builder;
     Driver::Driver app;
 
+    bool quicken_flag = false;
+    bool feedback_flag = true;
+    int slice_budget = 0;
+    int jit_threshold = 0;
+    int trace_threshold = 0;
+    int gc_max_pause = 0;
+    int gc_growth_percent = 200;
+    int gc_threads = 0;
+    auto heap_report = Driver::HeapReportMode::off;
+    std::string_view heap_snapshot_path;
+    int job_count = 1;
+    int repeat_count = 1;
+
+    for (auto opt_pos = 3; opt_pos < argc; ++opt_pos) {
+        std::string_view run_opt {argv[opt_pos]};
+
+        if (run_opt == "--quicken") {
+            quicken_flag = true;
+        } else if (run_opt == "--no-feedback") {
+            feedback_flag = false;
+        } else if (run_opt == "--slice" && opt_pos + 1 < argc) {
+            if (auto budget_opt = parse_count_option(argv[++opt_pos], 0); budget_opt) {
+                slice_budget = budget_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else if (run_opt == "--jit" && opt_pos + 1 < argc) {
+            if (auto threshold_opt = parse_count_option(argv[++opt_pos], 1); threshold_opt) {
+                jit_threshold = threshold_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else if (run_opt == "--trace" && opt_pos + 1 < argc) {
+            if (auto threshold_opt = parse_count_option(argv[++opt_pos], 1); threshold_opt) {
+                trace_threshold = threshold_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else if (run_opt == "--gc-pause" && opt_pos + 1 < argc) {
+            if (auto pause_opt = parse_count_option(argv[++opt_pos], 1); pause_opt) {
+                gc_max_pause = pause_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else if (run_opt == "--gc-growth" && opt_pos + 1 < argc) {
+            if (auto growth_opt = parse_count_option(argv[++opt_pos], 101); growth_opt) {
+                gc_growth_percent = growth_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else if (run_opt == "--gc-threads" && opt_pos + 1 < argc) {
+            if (auto threads_opt = parse_count_option(argv[++opt_pos], 1); threads_opt) {
+                gc_threads = threads_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else if (run_opt == "--heap-report") {
+            heap_report = std::max(heap_report, Driver::HeapReportMode::at_exit);
+        } else if (run_opt == "--heap-report-gc") {
+            heap_report = Driver::HeapReportMode::each_gc;
+        } else if (run_opt == "--heap-snapshot" && opt_pos + 1 < argc) {
+            heap_snapshot_path = argv[++opt_pos];
+        } else if (run_opt == "--jobs" && opt_pos + 1 < argc) {
+            if (auto jobs_opt = parse_count_option(argv[++opt_pos], 1); jobs_opt) {
+                job_count = jobs_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else if (run_opt == "--repeat" && opt_pos + 1 < argc) {
+            if (auto repeat_opt = parse_count_option(argv[++opt_pos], 1); repeat_opt) {
+                repeat_count = repeat_opt.value();
+            } else {
+                print_usage();
+
+                return 1;
+            }
+        } else {
+            print_usage();
+
+            return 1;
+        }
+    }
+
     if (arg_1 == "info") {
-        std::println("minuetm v{}.{}.{}\n\nUsage: ./minuetm [info | compile-only <main-file> | run <main-file>]\n\tinfo []: shows usage info and version.", minuet_version_major, minuet_version_minor, minuet_version_patch);
+        print_usage();
 
         return 0;
     } else if (arg_1 == "compile-only" && !arg_2.empty()) {
         app = driver_builder.config_ir_dumper(true)->config_bc_dumper(true)->build();
     } else if (arg_1 == "run" && !arg_2.empty()) {
-        app = driver_builder.config_ir_dumper(false)->config_bc_dumper(false)->build();
+        app = driver_builder.config_ir_dumper(false)->config_bc_dumper(false)->config_quickening(quicken_flag)->config_type_feedback(feedback_flag)->config_slice_budget(slice_budget)->config_jit(jit_threshold)->config_trace(trace_threshold)->config_gc_pause(gc_max_pause)->config_gc_growth(gc_growth_percent)->config_gc_threads(gc_threads)->config_heap_report(heap_report)->config_heap_snapshot(heap_snapshot_path)->config_jobs(job_count, repeat_count)->build();
     } else {
-        std::println("minuetm v{}.{}.{}\n\nUsage: ./minuetm [info | compile-only <main-file> | run <main-file>]\n\tinfo []: shows usage info and version.", minuet_version_major, minuet_version_minor, minuet_version_patch);
+        print_usage();
 
         return 1;
     }
@@ -82,10 +294,10 @@ int main(int argc, char* argv[]) {
     app.register_native_proc({"prompt_int", Intrinsics::native_prompt_int});
     app.register_native_proc({"prompt_float", Intrinsics::native_prompt_float});
 
-    app.register_native_proc({"len_of", Intrinsics::native_len_of});
-    app.register_native_proc({"list_push_back", Intrinsics::native_list_push_back});
-    app.register_native_proc({"list_pop_back", Intrinsics::native_list_pop_back});
-    app.register_native_proc({"list_pop_front", Intrinsics::native_list_pop_front});
+    app.register_native_proc({"len_of", Intrinsics::native_len_of, true});
+    app.register_native_proc({"list_push_back", Intrinsics::native_list_push_back, true});
+    app.register_native_proc({"list_pop_back", Intrinsics::native_list_pop_back, true});
+    app.register_native_proc({"list_pop_front", Intrinsics::native_list_pop_front, true});
     app.register_native_proc({"list_concat", Intrinsics::native_list_concat});
 
     return app(arg_2) ? 0 : 1 ;
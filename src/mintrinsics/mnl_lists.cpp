@@ -22,12 +22,10 @@ namespace Minuet::Intrinsics {
         }
 
         if (auto obj_ptr = target_arg.to_object_ptr(); obj_ptr) {
-            if (obj_ptr->get_tag() == Runtime::ObjectTag::sequence && !obj_ptr->is_frozen()) {
-                if (obj_ptr->push_value(std::move(new_item_arg))) {
-                    vm.handle_native_fn_return(std::move(target_arg), argc);
+            if (vm.handle_native_fn_push(*obj_ptr, new_item_arg)) {
+                vm.handle_native_fn_return(std::move(target_arg), argc);
 
-                    return true;
-                }
+                return true;
             }
         }
 
@@ -87,7 +85,7 @@ namespace Minuet::Intrinsics {
         }
 
         for (const auto& source_items = source_arg_p->items(); const auto& item : source_items) {
-            if (!target_arg_p->push_value(item)) {
+            if (!vm.handle_native_fn_push(*target_arg_p, item)) {
                 return false;
             }
         }
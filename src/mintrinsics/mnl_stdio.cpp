@@ -1,14 +1,20 @@
 #include <iostream>
+#include <mutex>
 #include <print>
 #include <utility>
 
 #include "mintrinsics/mnl_stdio.hpp"
 
 namespace Minuet::Intrinsics {
+    /// NOTE: Engines on several threads share the console, so each native I/O operation holds this lock to keep its line whole.
+    static std::mutex console_mutex;
+
     [[nodiscard]] auto native_print_value(Runtime::VM::Engine& vm, int16_t argc) -> bool {
         const auto& argument_value = vm.handle_native_fn_access(argc, 0);
+        const auto argument_text = argument_value.to_string();
 
-        std::println("{}", argument_value.to_string());
+        std::scoped_lock console_lock {console_mutex};
+        std::println("{}", argument_text);
 
         return true;
     }
@@ -16,7 +22,10 @@ namespace Minuet::Intrinsics {
     [[nodiscard]] auto native_prompt_int(Runtime::VM::Engine& vm, int16_t argc) -> bool {
         int temp_i32 = 0;
 
-        std::cin >> temp_i32;
+        {
+            std::scoped_lock console_lock {console_mutex};
+            std::cin >> temp_i32;
+        }
 
         Runtime::FastValue temp_value {temp_i32};
 
@@ -28,7 +37,10 @@ namespace Minuet::Intrinsics {
     [[nodiscard]] auto native_prompt_float(Runtime::VM::Engine& vm, int16_t argc) -> bool {
         double temp_f64 = 0;
 
-        std::cin >> temp_f64;
+        {
+            std::scoped_lock console_lock {console_mutex};
+            std::cin >> temp_f64;
+        }
 
         Runtime::FastValue temp_value {temp_f64};
 
@@ -10,11 +10,14 @@ namespace Minuet::Runtime::Code {
         "seq_obj_pop",
         "seq_obj_get",
         "frz_seq_obj",
+        "seq_len",
         "load_const",
         "mov",
         "neg",
         "inc",
         "dec",
+        "add_assign",
+        "sub_assign",
         "mul",
         "div",
         "mod",
@@ -29,10 +32,60 @@ namespace Minuet::Runtime::Code {
         "jump",
         "jump_if",
         "jump_else",
+        "jeq",
+        "jne",
+        "jlt",
+        "jgt",
+        "jle",
+        "jge",
+        "jnlt",
+        "jngt",
+        "jnle",
+        "jnge",
         "call",
+        "tail_call",
         "native_call",
+        "spawn",
+        "yield",
         "ret",
         "halt",
+        "mul_rr",
+        "mul_rc",
+        "mul_cr",
+        "div_rr",
+        "div_rc",
+        "div_cr",
+        "mod_rr",
+        "mod_rc",
+        "mod_cr",
+        "add_rr",
+        "add_rc",
+        "add_cr",
+        "sub_rr",
+        "sub_rc",
+        "sub_cr",
+        "equ_rr",
+        "equ_rc",
+        "equ_cr",
+        "neq_rr",
+        "neq_rc",
+        "neq_cr",
+        "lt_rr",
+        "lt_rc",
+        "lt_cr",
+        "gt_rr",
+        "gt_rc",
+        "gt_cr",
+        "lte_rr",
+        "lte_rc",
+        "lte_cr",
+        "gte_rr",
+        "gte_rc",
+        "gte_cr",
+        "add_i32",
+        "sub_i32",
+        "mul_i32",
+        "lt_i32",
     };
 
     static constexpr std::array<std::string_view, static_cast<std::size_t>(ArgMode::last)> arg_mode_names = {
@@ -50,4 +103,71 @@ namespace Minuet::Runtime::Code {
     auto arg_mode_name(ArgMode mode) -> std::string_view {
         return arg_mode_names[static_cast<std::size_t>(mode)];
     }
+
+    auto make_feedback(const std::vector<Chunk>& chunks) -> std::vector<ChunkFeedback> {
+        std::vector<ChunkFeedback> result;
+        result.reserve(chunks.size());
+
+        for (const auto& chunk : chunks) {
+            result.emplace_back(chunk.size(), SiteFeedback {
+                .generic_op = Opcode::nop,
+                .int32_hits = 0,
+                .unstable = false,
+            });
+        }
+
+        return result;
+    }
+
+    /// NOTE: Each quickenable opcode from `mul` to `gte` owns 3 consecutive specialized opcodes starting at `mul_rr`, ordered as `_rr, _rc, _cr`.
+    static constexpr auto quick_variant_count = 3;
+
+    [[nodiscard]] static auto quicken_opcode(Opcode op, ArgMode lhs_mode, ArgMode rhs_mode) noexcept -> Opcode {
+        if (op < Opcode::mul || op > Opcode::gte) {
+            return op;
+        }
+
+        int variant_offset;
+
+        if (lhs_mode == ArgMode::reg && rhs_mode == ArgMode::reg) {
+            variant_offset = 0;
+        } else if (lhs_mode == ArgMode::reg && rhs_mode == ArgMode::constant) {
+            variant_offset = 1;
+        } else if (lhs_mode == ArgMode::constant && rhs_mode == ArgMode::reg) {
+            variant_offset = 2;
+        } else {
+            return op;
+        }
+
+        const auto base_offset = static_cast<int>(op) - static_cast<int>(Opcode::mul);
+
+        return static_cast<Opcode>(static_cast<int>(Opcode::mul_rr) + base_offset * quick_variant_count + variant_offset);
+    }
+
+    auto generic_opcode(Opcode op) noexcept -> Opcode {
+        if (op >= Opcode::mul_rr && op <= Opcode::gte_cr) {
+            const auto quick_offset = static_cast<int>(op) - static_cast<int>(Opcode::mul_rr);
+
+            return static_cast<Opcode>(static_cast<int>(Opcode::mul) + quick_offset / quick_variant_count);
+        }
+
+        switch (op) {
+            case Opcode::add_i32: return Opcode::add;
+            case Opcode::sub_i32: return Opcode::sub;
+            case Opcode::mul_i32: return Opcode::mul;
+            case Opcode::lt_i32: return Opcode::lt;
+            default: return op;
+        }
+    }
+
+    void quicken_program(Program& prgm) noexcept {
+        for (auto& chunk : prgm.chunks) {
+            for (auto& inst : chunk) {
+                const auto lhs_mode = static_cast<ArgMode>((inst.metadata & 0b00001111000000) >> 6);
+                const auto rhs_mode = static_cast<ArgMode>((inst.metadata & 0b11110000000000) >> 10);
+
+                inst.op = quicken_opcode(inst.op, lhs_mode, rhs_mode);
+            }
+        }
+    }
 }
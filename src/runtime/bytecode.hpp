@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <string_view>
 
@@ -16,11 +18,14 @@ namespace Minuet::Runtime::Code {
         seq_obj_pop,
         seq_obj_get,
         frz_seq_obj,
+        seq_len,
         load_const,
         mov,
         neg,
         inc,
         dec,
+        add_assign,
+        sub_assign,
         mul,
         div,
         mod,
@@ -35,10 +40,63 @@ namespace Minuet::Runtime::Code {
         jump,
         jump_if,
         jump_else,
+        // NOTE: compare-and-branch forms fused by the emitter from a compare & the conditional jump consuming its result
+        jeq,
+        jne,
+        jlt,
+        jgt,
+        jle,
+        jge,
+        jnlt,
+        jngt,
+        jnle,
+        jnge,
         call,
+        tail_call,
         native_call,
+        spawn,
+        yield,
         ret,
         halt,
+        // NOTE: operand-specialized forms from `quicken_program()`: `_rr` takes 2 registers, `_rc` a register & constant, `_cr` a constant & register
+        mul_rr,
+        mul_rc,
+        mul_cr,
+        div_rr,
+        div_rc,
+        div_cr,
+        mod_rr,
+        mod_rc,
+        mod_cr,
+        add_rr,
+        add_rc,
+        add_cr,
+        sub_rr,
+        sub_rc,
+        sub_cr,
+        equ_rr,
+        equ_rc,
+        equ_cr,
+        neq_rr,
+        neq_rc,
+        neq_cr,
+        lt_rr,
+        lt_rc,
+        lt_cr,
+        gt_rr,
+        gt_rc,
+        gt_cr,
+        lte_rr,
+        lte_rc,
+        lte_cr,
+        gte_rr,
+        gte_rc,
+        gte_cr,
+        // NOTE: int32-specialized forms installed by type feedback, which deoptimize back to the recorded generic opcode
+        add_i32,
+        sub_i32,
+        mul_i32,
+        lt_i32,
         last,
     };
 
@@ -76,11 +134,43 @@ namespace Minuet::Runtime::Code {
 
     using Chunk = std::vector<Instruction>;
 
+    /// NOTE: Type feedback of one instruction slot, which only matters for `add, sub, mul, lt` sites.
+    struct SiteFeedback {
+        Opcode generic_op;  // opcode to restore on deoptimization
+        uint8_t int32_hits; // executions seen with only int32 operands
+        bool unstable;      // a non-int32 operand was seen, so the site stays generic
+    };
+
+    using ChunkFeedback = std::vector<SiteFeedback>;
+
+    /// NOTE: Register window of a function's chunk. Params occupy the first registers, and `temp_count` covers every register the chunk touches including them.
+    struct FrameLayout {
+        int16_t param_count;
+        int16_t temp_count;
+    };
+
+    /// NOTE: After emitting, `constants, frames, function_ids, entry_id` are read-only. Only `quicken_program()` and engines in `FeedbackMode::shared` write `chunks` & `feedback`, so engines sharing a program across threads need it quickened beforehand and must keep their feedback `isolated` or `off`.
     struct Program {
         std::vector<Runtime::FastValue> constants;
         std::vector<Chunk> chunks;
+        std::vector<FrameLayout> frames;
+        std::vector<ChunkFeedback> feedback; // NOTE: empty until an engine shares its type feedback through the program.
+        std::unordered_map<std::string, int16_t> function_ids; // NOTE: maps each function's name to its chunk ID for embedders.
         std::optional<int> entry_id;
     };
+
+    /**
+     * @brief Creates blank type feedback slots for every instruction of the given chunks, e.g for an engine's private copy of them.
+     */
+    [[nodiscard]] auto make_feedback(const std::vector<Chunk>& chunks) -> std::vector<ChunkFeedback>;
+
+    /// NOTE: Maps quickened & int32 forms back to their generic opcode, whose handlers accept the same args & metadata.
+    [[nodiscard]] auto generic_opcode(Opcode op) noexcept -> Opcode;
+
+    /**
+     * @brief Rewrites every binary arithmetic or comparison instruction whose operands are register / constant combinations into its operand-specialized opcode (e.g `add` of `reg, const` into `add_rc`). The args and metadata are kept as-is, so the rewritten code still disassembles the same way. Already specialized instructions are skipped.
+     */
+    void quicken_program(Program& prgm) noexcept;
 }
 
 #endif
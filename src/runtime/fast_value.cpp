@@ -3,68 +3,54 @@
 
 namespace Minuet::Runtime {
     auto FastValue::to_scalar() noexcept -> std::optional<int> {
-        if (m_tag == FVTag::int32) {
-            return m_data.scalar_v;
+        if (tag() == FVTag::int32) {
+            return raw_int();
         }
 
         return {};
     }
 
     auto FastValue::to_object_ptr() noexcept -> HeapValuePtr {
-        return (m_tag == FVTag::sequence)
-            ? m_data.obj_p
+        return (tag() == FVTag::sequence)
+            ? raw_obj()
             : nullptr;
     }
 
     auto FastValue::negate() & -> bool {
         switch (tag()) {
         case FVTag::boolean:
-            m_data.scalar_v ^= 0b1;
+            *this = FastValue {raw_int() == 0};
             return true;
         case FVTag::val_ref:
-            return m_data.fv_p->negate();
+            return raw_ref()->negate();
         default:
             return false;
         }
     }
 
-    auto FastValue::emplace_other(const FastValue& arg) & noexcept -> bool {        
+    auto FastValue::emplace_other(const FastValue& arg) & noexcept -> bool {
         const auto self_tag = tag();
         const auto arg_tag = arg.tag();
 
         if (self_tag == FVTag::val_ref && arg_tag == FVTag::val_ref) {
-            m_data.fv_p = arg.m_data.fv_p;
+            *this = arg;
             return true;
         } else if (self_tag == FVTag::val_ref && arg_tag != FVTag::val_ref) {
-            if (m_data.fv_p != nullptr) {
-                return m_data.fv_p->emplace_other(arg);
+            if (auto* target_p = raw_ref(); target_p != nullptr) {
+                return target_p->emplace_other(arg);
             }
             return false;
         }
 
-        switch (arg_tag) {
-        case FVTag::dud:
-            m_data.dud = 0;
-            break;
-        case FVTag::boolean:
-        case FVTag::int32:
-            m_data.scalar_v = arg.m_data.scalar_v;
-            break;
-        case FVTag::flt64:
-            m_data.dbl_v = arg.m_data.dbl_v;
-            break;
-        case FVTag::val_ref:
-            if (!emplace_other(*arg.m_data.fv_p)) {
-                return false;
+        /// NOTE: A plain value takes a copy of what an argument reference points to.
+        if (arg_tag == FVTag::val_ref) {
+            if (auto* source_p = arg.raw_ref(); source_p != nullptr) {
+                return emplace_other(*source_p);
             }
-            break;
-        case FVTag::sequence:
-        default:
-            m_data.obj_p = arg.m_data.obj_p;
-            break;
+            return false;
         }
 
-        m_tag = arg_tag;
+        *this = arg;
         return true;
     }
 
@@ -77,11 +63,11 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::int32:
-            return m_data.scalar_v * arg.m_data.scalar_v;
+            return raw_int() * arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v * arg.m_data.dbl_v;
+            return raw_dbl() * arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator*(arg);
+            return raw_ref()->operator*(arg);
         default:
             return {};
         }
@@ -97,18 +83,18 @@ namespace Minuet::Runtime {
         switch (self_tag) {
         case FVTag::int32:
             if (arg) {
-                return m_data.scalar_v / arg.m_data.scalar_v;
+                return raw_int() / arg.raw_int();
             }
 
             return {};
         case FVTag::flt64:
             if (arg) {
-                return m_data.dbl_v / arg.m_data.dbl_v;
+                return raw_dbl() / arg.raw_dbl();
             }
 
             return {};
         case FVTag::val_ref:
-            return m_data.fv_p->operator/(arg);
+            return raw_ref()->operator/(arg);
         default:
             return {};
         }
@@ -124,12 +110,12 @@ namespace Minuet::Runtime {
         switch (self_tag) {
         case FVTag::int32:
             if (arg) {
-                return m_data.scalar_v % arg.m_data.scalar_v;
+                return raw_int() % arg.raw_int();
             }
 
             return {};
         case FVTag::val_ref:
-            return m_data.fv_p->operator%(arg);
+            return raw_ref()->operator%(arg);
         default:
             return {};
         }
@@ -144,11 +130,11 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::int32:
-            return m_data.scalar_v + arg.m_data.scalar_v;
+            return raw_int() + arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v + arg.m_data.dbl_v;
+            return raw_dbl() + arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator+(arg);
+            return raw_ref()->operator+(arg);
         default:
             return {};
         }
@@ -163,11 +149,11 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::int32:
-            return m_data.scalar_v - arg.m_data.scalar_v;
+            return raw_int() - arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v - arg.m_data.dbl_v;
+            return raw_dbl() - arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator-(arg);
+            return raw_ref()->operator-(arg);
         default:
             return {};
         }
@@ -177,24 +163,22 @@ namespace Minuet::Runtime {
         const auto self_tag = tag();
 
         if (self_tag != arg.tag() && self_tag != FVTag::val_ref) {
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
 
             return *this;
         }
 
         switch (self_tag) {
         case FVTag::int32:
-            m_data.scalar_v *= arg.m_data.scalar_v;
+            *this = FastValue {raw_int() * arg.raw_int()};
             break;
         case FVTag::flt64:
-            m_data.dbl_v *= arg.m_data.dbl_v;
+            *this = FastValue {raw_dbl() * arg.raw_dbl()};
             break;
         case FVTag::val_ref:
-            return m_data.fv_p->operator*=(arg);
+            return raw_ref()->operator*=(arg);
         default:
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
             break;
         }
 
@@ -205,8 +189,7 @@ namespace Minuet::Runtime {
         const auto self_tag = tag();
 
         if (self_tag != arg.tag() && self_tag != FVTag::val_ref) {
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
 
             return *this;
         }
@@ -214,25 +197,22 @@ namespace Minuet::Runtime {
         switch (self_tag) {
         case FVTag::int32:
             if (arg) {
-                m_data.scalar_v /= arg.m_data.scalar_v;
+                *this = FastValue {raw_int() / arg.raw_int()};
             } else {
-                m_data.dud = 0;
-                m_tag = FVTag::dud;
+                *this = FastValue {};
             }
             break;
         case FVTag::flt64:
             if (arg) {
-                m_data.dbl_v /= arg.m_data.dbl_v;
+                *this = FastValue {raw_dbl() / arg.raw_dbl()};
             } else {
-                m_data.dud = 0;
-                m_tag = FVTag::dud;
+                *this = FastValue {};
             }
             break;
         case FVTag::val_ref:
-            return m_data.fv_p->operator/=(arg);
+            return raw_ref()->operator/=(arg);
         default:
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
             break;
         }
 
@@ -243,8 +223,7 @@ namespace Minuet::Runtime {
         const auto self_tag = tag();
 
         if (self_tag != arg.tag() && self_tag != FVTag::val_ref) {
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
 
             return *this;
         }
@@ -252,17 +231,15 @@ namespace Minuet::Runtime {
         switch (self_tag) {
         case FVTag::int32:
             if (arg) {
-                m_data.scalar_v /= arg.m_data.scalar_v;
+                *this = FastValue {raw_int() / arg.raw_int()};
             } else {
-                m_data.dud = 0;
-                m_tag = FVTag::dud;
+                *this = FastValue {};
             }
             break;
         case FVTag::val_ref:
-            return m_data.fv_p->operator%=(arg);
+            return raw_ref()->operator%=(arg);
         default:
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
             break;
         }
 
@@ -273,24 +250,22 @@ namespace Minuet::Runtime {
         const auto self_tag = tag();
 
         if (self_tag != arg.tag() && self_tag != FVTag::val_ref) {
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
 
             return *this;
         }
 
         switch (self_tag) {
         case FVTag::int32:
-            m_data.scalar_v += arg.m_data.scalar_v;
+            *this = FastValue {raw_int() + arg.raw_int()};
             break;
         case FVTag::flt64:
-            m_data.dbl_v += arg.m_data.dbl_v;
+            *this = FastValue {raw_dbl() + arg.raw_dbl()};
             break;
         case FVTag::val_ref:
-            return m_data.fv_p->operator+=(arg);
+            return raw_ref()->operator+=(arg);
         default:
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
             break;
         }
 
@@ -301,24 +276,22 @@ namespace Minuet::Runtime {
         const auto self_tag = tag();
 
         if (self_tag != arg.tag() && self_tag != FVTag::val_ref) {
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
 
             return *this;
         }
 
         switch (self_tag) {
         case FVTag::int32:
-            m_data.scalar_v -= arg.m_data.scalar_v;
+            *this = FastValue {raw_int() - arg.raw_int()};
             break;
         case FVTag::flt64:
-            m_data.dbl_v -= arg.m_data.dbl_v;
+            *this = FastValue {raw_dbl() - arg.raw_dbl()};
             break;
         case FVTag::val_ref:
-            return m_data.fv_p->operator-=(arg);
+            return raw_ref()->operator-=(arg);
         default:
-            m_data.dud = 0;
-            m_tag = FVTag::dud;
+            *this = FastValue {};
             break;
         }
 
@@ -334,13 +307,13 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::boolean:
-            return m_data.scalar_v == arg.m_data.scalar_v;
+            return raw_int() == arg.raw_int();
         case FVTag::int32:
-            return m_data.scalar_v == arg.m_data.scalar_v;
+            return raw_int() == arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v == arg.m_data.dbl_v;
+            return raw_dbl() == arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator==(arg);
+            return raw_ref()->operator==(arg);
         // case FVTag::sequence:
         // break;
         default:
@@ -359,11 +332,11 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::int32:
-            return m_data.scalar_v < arg.m_data.scalar_v;
+            return raw_int() < arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v < arg.m_data.dbl_v;
+            return raw_dbl() < arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator<(arg);
+            return raw_ref()->operator<(arg);
         default:
             break;
         }
@@ -380,11 +353,11 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::int32:
-            return m_data.scalar_v > arg.m_data.scalar_v;
+            return raw_int() > arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v > arg.m_data.dbl_v;
+            return raw_dbl() > arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator>(arg);
+            return raw_ref()->operator>(arg);
         default:
             break;
         }
@@ -401,11 +374,11 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::int32:
-            return m_data.scalar_v <= arg.m_data.scalar_v;
+            return raw_int() <= arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v <= arg.m_data.dbl_v;
+            return raw_dbl() <= arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator<=(arg);
+            return raw_ref()->operator<=(arg);
         default:
             break;
         }
@@ -422,11 +395,11 @@ namespace Minuet::Runtime {
 
         switch (self_tag) {
         case FVTag::int32:
-            return m_data.scalar_v >= arg.m_data.scalar_v;
+            return raw_int() >= arg.raw_int();
         case FVTag::flt64:
-            return m_data.dbl_v >= arg.m_data.dbl_v;
+            return raw_dbl() >= arg.raw_dbl();
         case FVTag::val_ref:
-            return m_data.fv_p->operator>=(arg);
+            return raw_ref()->operator>=(arg);
         default:
             break;
         }
@@ -437,15 +410,15 @@ namespace Minuet::Runtime {
     [[nodiscard]] auto FastValue::to_string() const& -> std::string {
         switch (tag()) {
         case FVTag::boolean:
-            return std::format("{}", m_data.scalar_v != 0);
+            return std::format("{}", raw_int() != 0);
         case FVTag::int32:
-            return std::format("{}", m_data.scalar_v);
+            return std::format("{}", raw_int());
         case FVTag::flt64:
-            return std::format("{}", m_data.dbl_v);
+            return std::format("{}", raw_dbl());
         case FVTag::val_ref:
-            return std::format("ref(FastValue({}))", m_data.fv_p->to_string());
+            return std::format("ref(FastValue({}))", raw_ref()->to_string());
         case FVTag::sequence:
-            return m_data.obj_p->to_string();
+            return raw_obj()->to_string();
         case FVTag::dud:
             return "(dud)";
         }
@@ -1,15 +1,27 @@
 #ifndef MINUET_FAST_VALUE_HPP
 #define MINUET_FAST_VALUE_HPP
 
+#include <atomic>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <vector>
 #include <string>
 
+#include "runtime/heap_allocators.hpp"
+
+#ifndef MINUET_NAN_BOXING
+    #define MINUET_NAN_BOXING 0
+#endif
+
 namespace Minuet::Runtime {
     /// NOTE: forward declaration of FastValue for HeapValueBase declaration
     class FastValue;
 
+    /// NOTE: item buffer of a sequence, which lives in its heap's payload pool
+    using ItemVector = std::vector<FastValue, PayloadAllocator<FastValue>>;
+
     enum class SequenceOpPolicy : int8_t {
         front,
         back,
@@ -20,26 +32,73 @@ namespace Minuet::Runtime {
         sequence,
     };
 
+    /// NOTE: Bit flags of an object header, which the collector & write barrier set and clear.
+    enum class ObjectMark : uint8_t {
+        none = 0b000,
+        marked = 0b001,     // reached by the running collection
+        young = 0b010,      // lives in the nursery
+        remembered = 0b100, // old object which may hold young objects
+    };
+
+    /// NOTE: Leads every heap object, so its type & GC state are readable without knowing the type. `size_class` is the object's footprint in 16-byte units.
+    struct ObjectHeader {
+        ObjectTag tag;
+        uint8_t marks;
+        uint8_t size_class;
+    };
+
+    /**
+     * @brief Base of every heap object. Its operations switch on the header's `ObjectTag` and forward to the concrete type through `visit_object()`, so objects have no vtable.
+     */
     class HeapValueBase {
+    protected:
+        ObjectHeader m_header;
+
+        constexpr HeapValueBase(ObjectTag tag, std::size_t footprint) noexcept
+        : m_header {.tag = tag, .marks = static_cast<uint8_t>(ObjectMark::none), .size_class = static_cast<uint8_t>((footprint + 15UL) / 16UL)} {}
+
     public:
-        virtual ~HeapValueBase() = default;
+        [[nodiscard]] constexpr auto get_tag() const& noexcept -> ObjectTag {
+            return m_header.tag;
+        }
+
+        [[nodiscard]] constexpr auto get_size_class() const& noexcept -> int {
+            return m_header.size_class;
+        }
 
-        virtual auto get_memory_score() const& noexcept -> std::size_t = 0;
-        virtual auto get_tag() const& noexcept -> ObjectTag = 0;
-        virtual auto get_size() const& noexcept -> int = 0;
-        virtual auto is_frozen() const& noexcept -> bool = 0;
+        [[nodiscard]] constexpr auto has_mark(ObjectMark mark) const& noexcept -> bool {
+            return (m_header.marks & static_cast<uint8_t>(mark)) != 0;
+        }
 
-        // virtual auto size() const& noexcept -> int = 0;
-        virtual auto push_value(FastValue arg) -> bool = 0;
-        virtual auto pop_value(SequenceOpPolicy mode) -> FastValue = 0;
-        virtual auto set_value(FastValue arg, std::size_t pos) -> bool = 0;
-        virtual auto get_value(std::size_t pos) -> std::optional<FastValue*> = 0;
+        constexpr void set_mark(ObjectMark mark, bool flag) & noexcept {
+            if (flag) {
+                m_header.marks |= static_cast<uint8_t>(mark);
+            } else {
+                m_header.marks &= static_cast<uint8_t>(~static_cast<uint8_t>(mark));
+            }
+        }
 
-        virtual void freeze() noexcept = 0;
-        virtual auto items() noexcept -> std::vector<FastValue>& = 0;
+        /// NOTE: Sets the `marked` bit by an atomic read-modify-write for marking on several threads, giving whether this call was the one which set it.
+        [[nodiscard]] auto claim_mark() & noexcept -> bool {
+            const auto old_marks = std::atomic_ref<uint8_t> {m_header.marks}.fetch_or(static_cast<uint8_t>(ObjectMark::marked), std::memory_order_relaxed);
 
-        virtual auto as_fast_value() noexcept -> FastValue = 0;
-        virtual auto to_string() const& noexcept -> std::string = 0;
+            return (old_marks & static_cast<uint8_t>(ObjectMark::marked)) == 0;
+        }
+
+        [[nodiscard]] auto get_memory_score() const& noexcept -> std::size_t;
+        [[nodiscard]] auto get_size() const& noexcept -> int;
+        [[nodiscard]] auto is_frozen() const& noexcept -> bool;
+
+        [[nodiscard]] auto push_value(FastValue arg) -> bool;
+        [[nodiscard]] auto pop_value(SequenceOpPolicy mode) -> FastValue;
+        [[nodiscard]] auto set_value(FastValue arg, std::size_t pos) -> bool;
+        [[nodiscard]] auto get_value(std::size_t pos) -> std::optional<FastValue*>;
+
+        void freeze() noexcept;
+        [[nodiscard]] auto items() noexcept -> ItemVector&;
+
+        [[nodiscard]] auto as_fast_value() noexcept -> FastValue;
+        [[nodiscard]] auto to_string() const& noexcept -> std::string;
     };
 
     /// NOTE: Convenience alias of a type-erased pointer to `HeapValueBase`.
@@ -55,8 +114,64 @@ namespace Minuet::Runtime {
         sequence,
     };
 
+    /**
+     * @brief Scalar or reference value of a register or sequence item. Built with `MINUET_NAN_BOXING`, it packs into one 64-bit NaN-boxed word. Otherwise, it is a payload union beside a separate tag, which pads to 16 bytes.
+     */
     class FastValue {
     private:
+#if MINUET_NAN_BOXING
+        /// NOTE: A double keeps its own bits, where any NaN becomes the positive quiet NaN. Every other type lives in the negative quiet NaN space above that: the top 16 bits hold `cm_box_base + tag` and the low 48 bits hold the payload, which fits user-space pointers of 64-bit targets.
+        static constexpr uint64_t cm_canonical_nan = 0x7FF8'0000'0000'0000ULL;
+        static constexpr uint64_t cm_box_base = 0xFFF9ULL;
+        static constexpr uint64_t cm_payload_mask = 0x0000'FFFF'FFFF'FFFFULL;
+
+        uint64_t m_bits;
+
+        [[nodiscard]] static constexpr auto box(FVTag tag, uint64_t payload) noexcept -> uint64_t {
+            return ((cm_box_base + static_cast<uint64_t>(tag)) << 48) | (payload & cm_payload_mask);
+        }
+
+        [[nodiscard]] constexpr auto raw_int() const noexcept -> int {
+            return static_cast<int>(static_cast<uint32_t>(m_bits));
+        }
+
+        [[nodiscard]] constexpr auto raw_dbl() const noexcept -> double {
+            return std::bit_cast<double>(m_bits);
+        }
+
+        [[nodiscard]] auto raw_ref() const noexcept -> FastValue* {
+            return reinterpret_cast<FastValue*>(m_bits & cm_payload_mask);
+        }
+
+        [[nodiscard]] auto raw_obj() const noexcept -> HeapValueBase* {
+            return reinterpret_cast<HeapValueBase*>(m_bits & cm_payload_mask);
+        }
+
+    public:
+        constexpr FastValue() noexcept
+        : m_bits {box(FVTag::dud, 0)} {}
+
+        constexpr FastValue(bool b) noexcept
+        : m_bits {box(FVTag::boolean, static_cast<uint64_t>(b))} {}
+
+        constexpr FastValue(int i) noexcept
+        : m_bits {box(FVTag::int32, static_cast<uint32_t>(i))} {}
+
+        constexpr FastValue(double d) noexcept
+        : m_bits {(d != d) ? cm_canonical_nan : std::bit_cast<uint64_t>(d)} {}
+
+        FastValue(FastValue* ref_p) noexcept
+        : m_bits {box(FVTag::val_ref, reinterpret_cast<uintptr_t>(ref_p))} {}
+
+        FastValue(HeapValuePtr obj_p) noexcept
+        : m_bits {box(FVTag::sequence, reinterpret_cast<uintptr_t>(obj_p))} {}
+
+        [[nodiscard]] constexpr auto tag() const& noexcept -> FVTag {
+            const auto box_code = m_bits >> 48;
+
+            return (box_code >= cm_box_base) ? static_cast<FVTag>(box_code - cm_box_base) : FVTag::flt64;
+        }
+#else
         union {
             uint8_t dud;
             int scalar_v;
@@ -66,6 +181,22 @@ namespace Minuet::Runtime {
         } m_data;
         FVTag m_tag;
 
+        [[nodiscard]] constexpr auto raw_int() const noexcept -> int {
+            return m_data.scalar_v;
+        }
+
+        [[nodiscard]] constexpr auto raw_dbl() const noexcept -> double {
+            return m_data.dbl_v;
+        }
+
+        [[nodiscard]] constexpr auto raw_ref() const noexcept -> FastValue* {
+            return m_data.fv_p;
+        }
+
+        [[nodiscard]] constexpr auto raw_obj() const noexcept -> HeapValueBase* {
+            return m_data.obj_p;
+        }
+
     public:
         constexpr FastValue() noexcept
         : m_data {}, m_tag {FVTag::dud} {
@@ -100,12 +231,19 @@ namespace Minuet::Runtime {
         [[nodiscard]] constexpr auto tag() const& noexcept -> FVTag {
             return m_tag;
         }
+#endif
 
         [[nodiscard]] auto to_scalar() noexcept -> std::optional<int>;
+
+        /// NOTE: Only meaningful after checking for `FVTag::int32`, which the type-specialized VM handlers do.
+        [[nodiscard]] constexpr auto to_int32_unchecked() const& noexcept -> int {
+            return raw_int();
+        }
+
         [[nodiscard]] auto to_object_ptr() noexcept -> HeapValuePtr;
 
         [[nodiscard]] constexpr auto is_none() const& -> bool {
-            return m_tag == FVTag::dud;
+            return tag() == FVTag::dud;
         }
 
         [[nodiscard]] auto negate() & -> bool;
@@ -114,9 +252,9 @@ namespace Minuet::Runtime {
             switch (self.tag()) {
             case FVTag::boolean:
             case FVTag::int32:
-                return self.m_data.scalar_v != 0;
+                return self.raw_int() != 0;
             case FVTag::flt64:
-                return self.m_data.dbl_v != 0.0;
+                return self.raw_dbl() != 0.0;
             default:
                 return false;
             }
@@ -144,6 +282,11 @@ namespace Minuet::Runtime {
 
         [[nodiscard]] auto to_string() const& -> std::string;
     };
+
+#if MINUET_NAN_BOXING
+    static_assert(sizeof(void*) == 8, "NaN-boxing keeps pointers in a 48-bit payload, so it needs a 64-bit target");
+    static_assert(sizeof(FastValue) == 8);
+#endif
 }
 
 #endif
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+
+#include "runtime/heap_objects.hpp"
+#include "runtime/gc_workers.hpp"
+
+namespace Minuet::Runtime::GC {
+    /// NOTE: private stack size of a marking worker past which it shares half of that stack
+    static constexpr auto cm_spill_threshold = 128UL;
+
+    /// NOTE: Runs `work(worker_id, worker_count)` on the calling thread & up to `worker_count - 1` helper threads. Helpers only start working once all of them exist, so a helper which cannot be started just leaves the work to fewer threads.
+    template <typename Work>
+    void run_workers(std::size_t worker_count, Work& work) {
+        std::atomic<bool> released {false};
+        std::size_t started_count = 1UL;
+        std::vector<std::jthread> helpers;
+
+        try {
+            helpers.reserve(worker_count - 1UL);
+
+            for (auto worker_id = 1UL; worker_id < worker_count; ++worker_id) {
+                helpers.emplace_back([&released, &started_count, &work, worker_id]() {
+                    released.wait(false, std::memory_order_acquire);
+
+                    if (worker_id < started_count) {
+                        work(worker_id, started_count);
+                    }
+                });
+            }
+        } catch (const std::exception&) {}
+
+        started_count = helpers.size() + 1UL;
+        released.store(true, std::memory_order_release);
+        released.notify_all();
+
+        work(0UL, started_count);
+    }
+
+    MarkDeque::MarkDeque()
+    : m_lock {}, m_items {}, m_count {0UL} {}
+
+    auto MarkDeque::is_empty() const noexcept -> bool {
+        return m_count.load(std::memory_order_acquire) == 0UL;
+    }
+
+    void MarkDeque::push_back(std::span<const HeapValuePtr> gray_objects) {
+        std::scoped_lock guard {m_lock};
+
+        m_items.insert(m_items.end(), gray_objects.begin(), gray_objects.end());
+        m_count.store(m_items.size(), std::memory_order_release);
+    }
+
+    auto MarkDeque::pop_back() -> HeapValuePtr {
+        std::scoped_lock guard {m_lock};
+
+        if (m_items.empty()) {
+            return nullptr;
+        }
+
+        HeapValuePtr gray_p = m_items.back();
+        m_items.pop_back();
+        m_count.store(m_items.size(), std::memory_order_release);
+
+        return gray_p;
+    }
+
+    auto MarkDeque::steal_front() -> HeapValuePtr {
+        std::scoped_lock guard {m_lock};
+
+        if (m_items.empty()) {
+            return nullptr;
+        }
+
+        HeapValuePtr gray_p = m_items.front();
+        m_items.pop_front();
+        m_count.store(m_items.size(), std::memory_order_release);
+
+        return gray_p;
+    }
+
+    void trace_parallel(std::span<const HeapValuePtr> gray_objects, std::size_t worker_count) {
+        auto deques = std::make_unique<MarkDeque[]>(worker_count);
+        std::atomic<std::size_t> idle_count {0UL};
+
+        /// NOTE: The calling thread's worker owns the roots at first, and the others steal them from there.
+        deques[0].push_back(gray_objects);
+
+        auto find_work = [&deques](std::size_t self_id, std::size_t started_count) -> HeapValuePtr {
+            if (HeapValuePtr gray_p = deques[self_id].pop_back(); gray_p) {
+                return gray_p;
+            }
+
+            for (auto offset = 1UL; offset < started_count; ++offset) {
+                if (HeapValuePtr gray_p = deques[(self_id + offset) % started_count].steal_front(); gray_p) {
+                    return gray_p;
+                }
+            }
+
+            return nullptr;
+        };
+
+        auto any_shared_work = [&deques](std::size_t started_count) noexcept {
+            return std::any_of(deques.get(), deques.get() + started_count, [](const MarkDeque& deque) noexcept {
+                return !deque.is_empty();
+            });
+        };
+
+        /// NOTE: Only a deque's owner pushes to it, and an owner only goes idle after finding its deque empty. So once every worker is idle, no gray object is left anywhere.
+        auto run_worker = [&](std::size_t self_id, std::size_t started_count) {
+            std::vector<HeapValuePtr> local_stack;
+            local_stack.reserve(cm_spill_threshold * 2UL);
+
+            while (true) {
+                HeapValuePtr gray_p = nullptr;
+
+                if (!local_stack.empty()) {
+                    gray_p = local_stack.back();
+                    local_stack.pop_back();
+                } else if (gray_p = find_work(self_id, started_count); !gray_p) {
+                    idle_count.fetch_add(1UL);
+
+                    while (!gray_p) {
+                        if (idle_count.load() == started_count) {
+                            return;
+                        }
+
+                        if (any_shared_work(started_count)) {
+                            idle_count.fetch_sub(1UL);
+
+                            if (gray_p = find_work(self_id, started_count); !gray_p) {
+                                idle_count.fetch_add(1UL);
+                            }
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+
+                visit_object(*gray_p, [&local_stack](auto& object) noexcept {
+                    object.visit_children([&local_stack](HeapValuePtr child_p) noexcept {
+                        if (child_p->claim_mark()) {
+                            local_stack.emplace_back(child_p);
+                        }
+                    });
+                });
+
+                if (local_stack.size() > cm_spill_threshold && deques[self_id].is_empty()) {
+                    const auto shared_count = local_stack.size() / 2UL;
+
+                    deques[self_id].push_back({local_stack.data(), shared_count});
+                    local_stack.erase(local_stack.begin(), local_stack.begin() + shared_count);
+                }
+            }
+        };
+
+        run_workers(worker_count, run_worker);
+    }
+
+    auto sweep_parallel(std::span<const HeapObjectOwner> slots, std::size_t worker_count) -> SweepResult {
+        std::vector<std::vector<std::size_t>> dead_ranges(worker_count);
+        std::vector<std::size_t> live_bytes_of_ranges(worker_count, 0UL);
+
+        auto run_worker = [&slots, &dead_ranges, &live_bytes_of_ranges](std::size_t self_id, std::size_t started_count) {
+            const auto range_length = (slots.size() + started_count - 1UL) / started_count;
+            const auto range_begin = std::min(self_id * range_length, slots.size());
+            const auto range_end = std::min(range_begin + range_length, slots.size());
+            auto& dead_ids = dead_ranges[self_id];
+            auto live_bytes = 0UL;
+
+            for (auto slot_id = range_begin; slot_id < range_end; ++slot_id) {
+                const auto& object_cell = slots[slot_id];
+
+                if (!object_cell) {
+                    continue;
+                }
+
+                if (object_cell->has_mark(ObjectMark::marked)) {
+                    object_cell->set_mark(ObjectMark::marked, false);
+                    live_bytes += HeapStorage::bytes_of(*object_cell);
+                } else {
+                    dead_ids.emplace_back(slot_id);
+                }
+            }
+
+            live_bytes_of_ranges[self_id] = live_bytes;
+        };
+
+        run_workers(worker_count, run_worker);
+
+        SweepResult result {
+            .dead_ids = {},
+            .live_bytes = 0UL,
+        };
+
+        for (auto range_id = 0UL; range_id < worker_count; ++range_id) {
+            result.dead_ids.insert(result.dead_ids.end(), dead_ranges[range_id].begin(), dead_ranges[range_id].end());
+            result.live_bytes += live_bytes_of_ranges[range_id];
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef MINUET_RUNTIME_GC_WORKERS_HPP
+#define MINUET_RUNTIME_GC_WORKERS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "runtime/fast_value.hpp"
+#include "runtime/heap_storage.hpp"
+
+namespace Minuet::Runtime::GC {
+    /**
+     * @brief Gray objects which one marking worker shares with the others. The owner pushes & pops at the back, while idle workers steal the oldest objects from the front, which tend to lead to the largest unmarked subgraphs.
+     */
+    class MarkDeque {
+    private:
+        std::mutex m_lock;
+        std::deque<HeapValuePtr> m_items;
+        std::atomic<std::size_t> m_count;
+
+    public:
+        MarkDeque();
+
+        /// NOTE: Lock-free check for idle workers, which may be stale by the time they try to steal.
+        [[nodiscard]] auto is_empty() const noexcept -> bool;
+
+        void push_back(std::span<const HeapValuePtr> gray_objects);
+
+        /// NOTE: Both pops give a null object if the deque is empty.
+        [[nodiscard]] auto pop_back() -> HeapValuePtr;
+        [[nodiscard]] auto steal_front() -> HeapValuePtr;
+    };
+
+    /**
+     * @brief Marks everything reachable from the already marked `gray_objects` on `worker_count` threads, including the calling one. Each worker traces from a private stack, spills part of it into its deque when its deque runs dry, and steals from the others once it runs out of work. Marking is done once every worker is idle at the same time.
+     */
+    void trace_parallel(std::span<const HeapValuePtr> gray_objects, std::size_t worker_count);
+
+    struct SweepResult {
+        std::vector<std::size_t> dead_ids;  // in ascending order
+        std::size_t live_bytes;             // total `HeapStorage::bytes_of()` of the survivors
+    };
+
+    /**
+     * @brief Sweeps the old slots in one contiguous range per worker: finds each unmarked object & clears the marks of the rest. The caller destroys the dead objects afterwards, since the heap's pools are not thread-safe.
+     */
+    [[nodiscard]] auto sweep_parallel(std::span<const HeapObjectOwner> slots, std::size_t worker_count) -> SweepResult;
+}
+
+#endif
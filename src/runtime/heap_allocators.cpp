@@ -0,0 +1,60 @@
+#include <new>
+
+#include "runtime/heap_allocators.hpp"
+
+namespace Minuet::Runtime {
+    BlockPool::BlockPool()
+    : m_chunks {}, m_free_lists {}, m_chunk_top {cm_chunk_bytes}, m_stats {} {}
+
+    auto BlockPool::allocate(std::size_t granules) -> void* {
+        const auto block_bytes = granules * cm_granule;
+
+        if (granules > cm_max_granules) {
+            void* block = ::operator new(block_bytes);
+
+            ++m_stats.allocations;
+            m_stats.bytes_in_use += block_bytes;
+
+            return block;
+        }
+
+        void* block = nullptr;
+
+        if (FreeBlock* free_p = m_free_lists[granules]; free_p != nullptr) {
+            m_free_lists[granules] = free_p->next;
+            block = free_p;
+        } else {
+            /// NOTE: The rest of a full chunk is left unused, since it is smaller than the largest block.
+            if (m_chunk_top + block_bytes > cm_chunk_bytes) {
+                m_chunks.emplace_back(new std::byte[cm_chunk_bytes]);
+                m_chunk_top = 0UL;
+            }
+
+            block = m_chunks.back().get() + m_chunk_top;
+            m_chunk_top += block_bytes;
+        }
+
+        ++m_stats.allocations;
+        m_stats.bytes_in_use += block_bytes;
+
+        return block;
+    }
+
+    void BlockPool::deallocate(void* block, std::size_t granules) noexcept {
+        const auto block_bytes = granules * cm_granule;
+
+        ++m_stats.frees;
+        m_stats.bytes_in_use -= block_bytes;
+
+        if (granules > cm_max_granules) {
+            ::operator delete(block);
+            return;
+        }
+
+        m_free_lists[granules] = new (block) FreeBlock {m_free_lists[granules]};
+    }
+
+    auto BlockPool::get_stats() const noexcept -> AllocatorStats {
+        return m_stats;
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef MINUET_RUNTIME_HEAP_ALLOCATORS_HPP
+#define MINUET_RUNTIME_HEAP_ALLOCATORS_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Minuet::Runtime {
+    /// NOTE: Counters of one allocator, where `bytes_in_use` counts whole blocks.
+    struct AllocatorStats {
+        std::size_t allocations;
+        std::size_t frees;
+        std::size_t bytes_in_use;
+    };
+
+    /**
+     * @brief Hands out blocks of 16-byte size classes, carved from 64 KiB chunks. A freed block goes onto the free list of its class for the next allocation of that class, and chunks are only released with the pool. Blocks past the largest class come from `operator new` instead. Not thread-safe, since each heap owns its pools.
+     */
+    class BlockPool {
+    public:
+        static constexpr auto cm_granule = 16UL;
+        static constexpr auto cm_max_granules = 16UL;
+
+    private:
+        static constexpr auto cm_chunk_bytes = 65536UL;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+        std::array<FreeBlock*, cm_max_granules + 1> m_free_lists;
+        std::size_t m_chunk_top;
+        AllocatorStats m_stats;
+
+    public:
+        BlockPool();
+
+        BlockPool(const BlockPool&) = delete;
+        auto operator=(const BlockPool&) -> BlockPool& = delete;
+
+        [[nodiscard]] static constexpr auto granules_of(std::size_t bytes) noexcept -> std::size_t {
+            return (bytes + cm_granule - 1UL) / cm_granule;
+        }
+
+        [[nodiscard]] auto allocate(std::size_t granules) -> void*;
+        void deallocate(void* block, std::size_t granules) noexcept;
+
+        [[nodiscard]] auto get_stats() const noexcept -> AllocatorStats;
+    };
+
+    /**
+     * @brief Allocator of sequence item buffers from their heap's payload pool. Without a pool, e.g for a default-constructed one, it falls back to `operator new`.
+     */
+    template <typename T>
+    class PayloadAllocator {
+    private:
+        template <typename U>
+        friend class PayloadAllocator;
+
+        BlockPool* m_pool;
+
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        constexpr PayloadAllocator() noexcept
+        : m_pool {nullptr} {}
+
+        constexpr explicit PayloadAllocator(BlockPool* pool) noexcept
+        : m_pool {pool} {}
+
+        template <typename U>
+        constexpr PayloadAllocator(const PayloadAllocator<U>& other) noexcept
+        : m_pool {other.m_pool} {}
+
+        [[nodiscard]] auto allocate(std::size_t count) -> T* {
+            if (!m_pool) {
+                return std::allocator<T> {}.allocate(count);
+            }
+
+            return static_cast<T*>(m_pool->allocate(BlockPool::granules_of(count * sizeof(T))));
+        }
+
+        void deallocate(T* items, std::size_t count) noexcept {
+            if (!m_pool) {
+                std::allocator<T> {}.deallocate(items, count);
+                return;
+            }
+
+            m_pool->deallocate(items, BlockPool::granules_of(count * sizeof(T)));
+        }
+
+        template <typename U>
+        [[nodiscard]] constexpr auto operator==(const PayloadAllocator<U>& other) const noexcept -> bool {
+            return m_pool == other.m_pool;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef MINUET_RUNTIME_HEAP_CENSUS_HPP
+#define MINUET_RUNTIME_HEAP_CENSUS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "runtime/heap_allocators.hpp"
+#include "runtime/fast_value.hpp"
+
+namespace Minuet::Runtime {
+    static constexpr auto object_tag_count = static_cast<std::size_t>(ObjectTag::sequence) + 1UL;
+
+    [[nodiscard]] constexpr auto object_tag_name(ObjectTag tag) noexcept -> std::string_view {
+        switch (tag) {
+        case ObjectTag::sequence:
+            return "sequence";
+        default:
+            return "dud";
+        }
+    }
+
+    /// NOTE: Resident objects of one `ObjectTag`, where `memory_score` sums their payload bytes.
+    struct TagCensus {
+        std::size_t object_count;
+        std::size_t element_count;
+        std::size_t memory_score;
+    };
+
+    struct SequenceSummary {
+        uint64_t object_id; // matches the object's id in a snapshot taken at the same point
+        std::size_t element_count;
+        std::size_t memory_score;
+        bool young;
+    };
+
+    /**
+     * @brief Counts of every object resident in a heap, young & old, for finding what a script keeps alive. Objects which a full collection already found dead but has yet to sweep are only counted in `dead_count`. Right after a full collection, the rest are exactly the live objects.
+     */
+    struct HeapCensus {
+        std::array<TagCensus, object_tag_count> by_tag;
+        std::vector<SequenceSummary> largest_sequences; // by memory score, largest first
+        std::size_t young_count;
+        std::size_t dead_count;
+
+        /// NOTE: Fragmentation of the old slots: free holes below the high-water mark & the longest run of them.
+        std::size_t slot_high_water;
+        std::size_t slot_capacity;
+        std::size_t hole_count;
+        std::size_t longest_hole_run;
+
+        std::size_t old_bytes;
+        std::size_t next_gc_bytes;
+        AllocatorStats object_slabs;
+        AllocatorStats payload_pool;
+    };
+
+    /**
+     * @brief Layout of a heap snapshot file in the host's byte order, for walking retention chains offline:
+     * - header: the 8 magic bytes, then `u64` object count & `u64` root count
+     * - roots: one `u64` object id per register holding an object, so an object may appear more than once
+     * - objects: `u64` id, `u8` tag, `u8` flags, `u16` zero, `u32` element count, `u64` memory score, `u32` reference count, `u32` zero, then one `u64` id per referenced object in item order
+     *
+     * Old objects have their slot index as id, and young ones their nursery granule index past the slots' high-water mark. A snapshot taken after `main` returned has no roots, since no frames are left.
+     */
+    namespace Snapshot {
+        static constexpr std::string_view magic = "MNLHEAP1";
+
+        enum class ObjectFlag : uint8_t {
+            young = 0b01,
+            frozen = 0b10,
+        };
+    }
+}
+
+#endif
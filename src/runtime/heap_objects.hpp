@@ -0,0 +1,31 @@
+#ifndef MINUET_RUNTIME_HEAP_OBJECTS_HPP
+#define MINUET_RUNTIME_HEAP_OBJECTS_HPP
+
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#include "runtime/fast_value.hpp"
+#include "runtime/sequence_value.hpp"
+
+namespace Minuet::Runtime {
+    /// NOTE: Gives `Concrete` the constness of `Base`.
+    template <typename Base, typename Concrete>
+    using LikeObject = std::conditional_t<std::is_const_v<Base>, const Concrete, Concrete>;
+
+    /**
+     * @brief Calls `fn` with the object as its concrete type, chosen by the header's tag. This switch is the only place which maps tags to object types, so a new type needs one more case here besides its creation in `HeapStorage`.
+     */
+    template <typename Object, typename Fn> requires std::same_as<std::remove_const_t<Object>, HeapValueBase>
+    constexpr auto visit_object(Object& object, Fn&& fn) -> decltype(auto) {
+        switch (object.get_tag()) {
+        case ObjectTag::sequence:
+            return std::forward<Fn>(fn)(static_cast<LikeObject<Object, SequenceValue>&>(object));
+        case ObjectTag::dud:
+        default:
+            std::unreachable();
+        }
+    }
+}
+
+#endif
@@ -1,51 +1,132 @@
+#include <algorithm>
+#include <cstddef>
 #include <memory>
-#include <queue>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <unordered_map>
 
-#include "runtime/sequence_value.hpp"
+#include <limits>
+
+#include "runtime/heap_objects.hpp"
+#include "runtime/gc_workers.hpp"
 #include "runtime/heap_storage.hpp"
 
 namespace Minuet::Runtime {
+    auto HeapValueBase::get_memory_score() const& noexcept -> std::size_t {
+        return visit_object(*this, [](const auto& object) noexcept { return object.get_memory_score(); });
+    }
+
+    auto HeapValueBase::get_size() const& noexcept -> int {
+        return visit_object(*this, [](const auto& object) noexcept { return object.get_size(); });
+    }
+
+    auto HeapValueBase::is_frozen() const& noexcept -> bool {
+        return visit_object(*this, [](const auto& object) noexcept { return object.is_frozen(); });
+    }
+
+    auto HeapValueBase::push_value(FastValue arg) -> bool {
+        return visit_object(*this, [arg](auto& object) { return object.push_value(arg); });
+    }
+
+    auto HeapValueBase::pop_value(SequenceOpPolicy mode) -> FastValue {
+        return visit_object(*this, [mode](auto& object) { return object.pop_value(mode); });
+    }
+
+    auto HeapValueBase::set_value(FastValue arg, std::size_t pos) -> bool {
+        return visit_object(*this, [arg, pos](auto& object) { return object.set_value(arg, pos); });
+    }
+
+    auto HeapValueBase::get_value(std::size_t pos) -> std::optional<FastValue*> {
+        return visit_object(*this, [pos](auto& object) { return object.get_value(pos); });
+    }
+
+    void HeapValueBase::freeze() noexcept {
+        visit_object(*this, [](auto& object) noexcept { object.freeze(); });
+    }
+
+    auto HeapValueBase::items() noexcept -> ItemVector& {
+        return visit_object(*this, [](auto& object) noexcept -> ItemVector& { return object.items(); });
+    }
+
+    auto HeapValueBase::as_fast_value() noexcept -> FastValue {
+        return {this};
+    }
+
+    auto HeapValueBase::to_string() const& noexcept -> std::string {
+        return visit_object(*this, [](const auto& object) noexcept { return object.to_string(); });
+    }
+
+    void HeapObjectDeleter::operator()(HeapValueBase* object_p) const noexcept {
+        const auto granules = static_cast<std::size_t>(object_p->get_size_class());
+
+        visit_object(*object_p, [](auto& object) noexcept { std::destroy_at(&object); });
+        slabs->deallocate(object_p, granules);
+    }
+
     HeapStorage::HeapStorage()
-    : m_hole_list {}, m_objects {}, m_dud {}, m_overhead {0UL}, m_next_id {0UL} {
-        m_objects.reserve(cm_normal_obj_capacity);
-        m_objects.resize(cm_normal_obj_capacity);
+    : HeapStorage {cm_default_growth_percent} {}
+
+    HeapStorage::HeapStorage(std::size_t growth_percent)
+    : m_object_slabs {std::make_unique<BlockPool>()}, m_payload_pool {std::make_unique<BlockPool>()}, m_hole_list {}, m_mark_stack {}, m_promote_stack {}, m_remembered {}, m_objects {}, m_nursery {new std::byte[cm_nursery_bytes]}, m_nursery_forwards {}, m_old_bytes {0UL}, m_next_gc_bytes {cm_min_gc_threshold}, m_sweep_live_bytes {0UL}, m_growth_percent {(growth_percent > 0UL) ? growth_percent : cm_default_growth_percent}, m_young_payload_bytes {0UL}, m_next_id {0UL}, m_nursery_top {0UL}, m_sweep_cursor {0UL}, m_gc_phase {GCPhase::idle}, m_untracked_stores {false} {
+        m_hole_list.reserve(cm_initial_slot_count);
+        m_mark_stack.reserve(cm_initial_slot_count + cm_nursery_granules);
+        m_promote_stack.reserve(cm_initial_slot_count + cm_nursery_granules);
+        m_objects.resize(cm_initial_slot_count);
+        m_nursery_forwards.resize(cm_nursery_granules);
     }
 
-    auto HeapStorage::is_ripe() const& noexcept -> bool {
-        return m_overhead >= cm_normal_gc_threshold;
+    HeapStorage::~HeapStorage() {
+        destroy_nursery();
     }
 
-    auto HeapStorage::try_create_value(ObjectTag obj_tag) noexcept -> std::unique_ptr<HeapValueBase>& {
-        switch (obj_tag) {
-        case ObjectTag::sequence:
-            {
-                const auto next_object_id = ([this]() {
-                    if (!m_hole_list.empty()) {
-                        const auto gap_id = m_hole_list.front();
-                        m_hole_list.pop();
+    auto HeapStorage::bytes_of(const HeapValueBase& object) noexcept -> std::size_t {
+        return object.get_size_class() * cm_nursery_granule + object.get_memory_score();
+    }
 
-                        return gap_id;
-                    }
+    auto HeapStorage::get_old_bytes() const noexcept -> std::size_t {
+        return m_old_bytes;
+    }
 
-                    return m_next_id;
-                })();
+    auto HeapStorage::get_next_gc_bytes() const noexcept -> std::size_t {
+        return m_next_gc_bytes;
+    }
 
-                m_objects[next_object_id] = std::make_unique<SequenceValue>();
-                m_overhead += cm_normal_obj_overhead;
-                ++m_next_id;
+    auto HeapStorage::get_object_slab_stats() const noexcept -> AllocatorStats {
+        return m_object_slabs->get_stats();
+    }
+
+    auto HeapStorage::get_payload_pool_stats() const noexcept -> AllocatorStats {
+        return m_payload_pool->get_stats();
+    }
 
-                return m_objects[next_object_id];
+    auto HeapStorage::try_create_value(ObjectTag obj_tag) noexcept -> HeapValuePtr {
+        auto place_young = [this]<typename Object>(std::type_identity<Object>) noexcept -> HeapValuePtr {
+            constexpr auto footprint = (sizeof(Object) + cm_nursery_granule - 1UL) / cm_nursery_granule * cm_nursery_granule;
+
+            if (m_nursery_top + footprint > cm_nursery_bytes) {
+                return nullptr;
             }
+
+            HeapValuePtr object_p = new (m_nursery.get() + m_nursery_top) Object {m_payload_pool.get()};
+            object_p->set_mark(ObjectMark::young, true);
+            m_nursery_top += footprint;
+
+            return object_p;
+        };
+
+        switch (obj_tag) {
+        case ObjectTag::sequence:
+            return place_young(std::type_identity<SequenceValue> {});
         default:
-            return m_dud;
+            return nullptr;
         }
     }
 
     [[nodiscard]] auto HeapStorage::try_destroy_value(std::size_t id) noexcept -> bool {
         if (auto& object_cell = m_objects[id]; object_cell) {
             object_cell = {};
-            m_overhead -= cm_normal_obj_overhead;
-            m_hole_list.emplace(id);
+            m_hole_list.emplace_back(id);
 
             return true;
         }
@@ -53,7 +134,439 @@ namespace Minuet::Runtime {
         return false;
     }
 
-    auto HeapStorage::get_objects() noexcept -> std::vector<std::unique_ptr<HeapValueBase>>& {
+    void HeapStorage::begin_marking() noexcept {
+        m_gc_phase = GCPhase::marking;
+    }
+
+    void HeapStorage::mark_object(HeapValuePtr object_p) noexcept {
+        if (!object_p->has_mark(ObjectMark::marked)) {
+            object_p->set_mark(ObjectMark::marked, true);
+            m_mark_stack.emplace_back(object_p);
+        }
+    }
+
+    auto HeapStorage::trace_some(std::size_t budget) noexcept -> bool {
+        for (; budget > 0UL && !m_mark_stack.empty(); --budget) {
+            HeapValuePtr gray_p = m_mark_stack.back();
+            m_mark_stack.pop_back();
+
+            visit_object(*gray_p, [this](auto& object) noexcept {
+                object.visit_children([this](HeapValuePtr child_p) noexcept {
+                    mark_object(child_p);
+                });
+            });
+        }
+
+        return m_mark_stack.empty();
+    }
+
+    auto HeapStorage::trace_all(std::size_t worker_count) -> bool {
+        if (worker_count <= 1UL || m_next_id < cm_parallel_min_slots || m_mark_stack.empty()) {
+            (void)trace_some(std::numeric_limits<std::size_t>::max());
+            return false;
+        }
+
+        GC::trace_parallel(m_mark_stack, worker_count);
+        m_mark_stack.clear();
+
+        return true;
+    }
+
+    void HeapStorage::begin_sweep() noexcept {
+        for (auto offset = 0UL; offset < m_nursery_top;) {
+            HeapValuePtr young_p = nursery_object_at(offset);
+
+            young_p->set_mark(ObjectMark::marked, false);
+            offset += young_p->get_size_class() * cm_nursery_granule;
+        }
+
+        /// NOTE: Marks are final here & nothing was freed yet, so the remembered objects which the sweep will free can still be told apart.
+        std::erase_if(m_remembered, [](HeapValuePtr remembered_p) noexcept {
+            return !remembered_p->has_mark(ObjectMark::marked);
+        });
+
+        m_sweep_cursor = 0UL;
+        m_sweep_live_bytes = 0UL;
+        m_gc_phase = GCPhase::sweeping;
+    }
+
+    auto HeapStorage::sweep_some(std::size_t budget) noexcept -> bool {
+        const auto sweep_end = m_sweep_cursor + std::min(budget, m_next_id - m_sweep_cursor);
+
+        for (; m_sweep_cursor < sweep_end; ++m_sweep_cursor) {
+            auto& object_cell = m_objects[m_sweep_cursor];
+
+            if (!object_cell) {
+                continue;
+            }
+
+            if (object_cell->has_mark(ObjectMark::marked)) {
+                object_cell->set_mark(ObjectMark::marked, false);
+                m_sweep_live_bytes += bytes_of(*object_cell);
+            } else {
+                (void)try_destroy_value(m_sweep_cursor);
+            }
+        }
+
+        if (m_sweep_cursor < m_next_id) {
+            return false;
+        }
+
+        finish_sweep();
+
+        return true;
+    }
+
+    auto HeapStorage::sweep_all(std::size_t worker_count) -> bool {
+        if (worker_count <= 1UL || m_next_id - m_sweep_cursor < cm_parallel_min_slots) {
+            (void)sweep_some(std::numeric_limits<std::size_t>::max());
+            return false;
+        }
+
+        const auto [dead_ids, live_bytes] = GC::sweep_parallel({m_objects.data() + m_sweep_cursor, m_next_id - m_sweep_cursor}, worker_count);
+
+        for (const auto dead_id : dead_ids) {
+            m_objects[m_sweep_cursor + dead_id] = {};
+            m_hole_list.emplace_back(m_sweep_cursor + dead_id);
+        }
+
+        m_sweep_live_bytes += live_bytes;
+        m_sweep_cursor = m_next_id;
+        finish_sweep();
+
+        return true;
+    }
+
+    void HeapStorage::finish_sweep() noexcept {
+        m_old_bytes = m_sweep_live_bytes;
+        m_next_gc_bytes = std::max(cm_min_gc_threshold, m_sweep_live_bytes * m_growth_percent / 100UL);
+        m_gc_phase = GCPhase::idle;
+    }
+
+    void HeapStorage::note_untracked_store() noexcept {
+        m_untracked_stores = true;
+    }
+
+    auto HeapStorage::promote(HeapValuePtr young_p) -> HeapValuePtr {
+        const auto granule_id = granule_of(young_p);
+
+        if (HeapValuePtr old_p = m_nursery_forwards[granule_id]; old_p != nullptr) {
+            return old_p;
+        }
+
+        /// NOTE: Moving a sequence keeps its item buffer, so references to its items stay valid.
+        HeapValuePtr old_p = visit_object(*young_p, [this](auto& object) -> HeapValuePtr {
+            using Object = std::remove_cvref_t<decltype(object)>;
+
+            return new (m_object_slabs->allocate(static_cast<std::size_t>(object.get_size_class()))) Object {std::move(object)};
+        });
+
+        const auto slot_id = claim_old_slot();
+
+        /// NOTE: The copy keeps the young object's mark while marking. While sweeping, a copy in a slot which the sweep has yet to reach must count as live.
+        old_p->set_mark(ObjectMark::young, false);
+
+        if (m_gc_phase == GCPhase::sweeping) {
+            old_p->set_mark(ObjectMark::marked, slot_id >= m_sweep_cursor);
+        }
+
+        const auto old_bytes = bytes_of(*old_p);
+
+        /// NOTE: The sweep only counts the survivors it reaches, so copies behind its cursor count here.
+        if (m_gc_phase == GCPhase::sweeping && slot_id < m_sweep_cursor) {
+            m_sweep_live_bytes += old_bytes;
+        }
+
+        m_objects[slot_id] = HeapObjectOwner {old_p, HeapObjectDeleter {m_object_slabs.get()}};
+        m_old_bytes += old_bytes;
+        m_nursery_forwards[granule_id] = old_p;
+        m_promote_stack.emplace_back(old_p);
+
+        return old_p;
+    }
+
+    void HeapStorage::finish_minor() {
+        auto forward_young = [this](HeapValuePtr child_p) {
+            return (child_p->has_mark(ObjectMark::young)) ? promote(child_p) : child_p;
+        };
+
+        forward_remembered();
+
+        while (!m_promote_stack.empty()) {
+            HeapValuePtr promoted_p = m_promote_stack.back();
+            m_promote_stack.pop_back();
+
+            visit_object(*promoted_p, [&forward_young](auto& object) {
+                object.forward_children(forward_young);
+            });
+        }
+
+        if (m_gc_phase == GCPhase::marking) {
+            forward_gray();
+        }
+
+        destroy_nursery();
+        std::fill(m_nursery_forwards.begin(), m_nursery_forwards.end(), nullptr);
+        m_untracked_stores = false;
+    }
+
+    void HeapStorage::reset() noexcept {
+        for (auto& object_cell : m_objects) {
+            object_cell = {};
+        }
+
+        destroy_nursery();
+        m_hole_list.clear();
+        m_mark_stack.clear();
+        m_promote_stack.clear();
+        m_remembered.clear();
+        m_old_bytes = 0UL;
+        m_next_gc_bytes = cm_min_gc_threshold;
+        m_sweep_live_bytes = 0UL;
+        m_next_id = 0UL;
+        m_sweep_cursor = 0UL;
+        m_gc_phase = GCPhase::idle;
+        m_untracked_stores = false;
+    }
+
+    auto HeapStorage::nursery_object_at(std::size_t offset) noexcept -> HeapValuePtr {
+        return std::launder(reinterpret_cast<HeapValueBase*>(m_nursery.get() + offset));
+    }
+
+    auto HeapStorage::granule_of(HeapValuePtr young_p) const noexcept -> std::size_t {
+        return (reinterpret_cast<std::byte*>(young_p) - m_nursery.get()) / cm_nursery_granule;
+    }
+
+    auto HeapStorage::claim_old_slot() -> std::size_t {
+        if (!m_hole_list.empty()) {
+            const auto slot_id = m_hole_list.back();
+            m_hole_list.pop_back();
+
+            return slot_id;
+        }
+
+        /// NOTE: Promotion cannot fail halfway, so a full old generation doubles its slots.
+        if (m_next_id == m_objects.size()) {
+            m_objects.resize(m_objects.size() * 2UL);
+            m_hole_list.reserve(m_objects.size());
+            m_mark_stack.reserve(m_objects.size() + cm_nursery_granules);
+            m_promote_stack.reserve(m_objects.size() + cm_nursery_granules);
+        }
+
+        return m_next_id++;
+    }
+
+    void HeapStorage::destroy_nursery() noexcept {
+        /// NOTE: A moved-from heap has no nursery left to clean up.
+        if (!m_nursery) {
+            return;
+        }
+
+        for (auto offset = 0UL; offset < m_nursery_top;) {
+            HeapValuePtr young_p = nursery_object_at(offset);
+
+            offset += young_p->get_size_class() * cm_nursery_granule;
+            visit_object(*young_p, [](auto& object) noexcept { std::destroy_at(&object); });
+        }
+
+        m_nursery_top = 0UL;
+        m_young_payload_bytes = 0UL;
+    }
+
+    void HeapStorage::forward_remembered() noexcept {
+        if (!m_untracked_stores) {
+            for (HeapValuePtr remembered_p : m_remembered) {
+                remembered_p->set_mark(ObjectMark::remembered, false);
+                m_promote_stack.emplace_back(remembered_p);
+            }
+
+            m_remembered.clear();
+
+            return;
+        }
+
+        /// NOTE: A store through a `val_ref` may have put a young object into any old sequence, so all of them get scanned.
+        for (auto cell_id = 0UL; cell_id < m_next_id; ++cell_id) {
+            auto& object_cell = m_objects[cell_id];
+
+            if (!object_cell) {
+                continue;
+            }
+
+            /// NOTE: Unmarked objects past the sweep cursor are garbage, whose children the sweep may have freed already.
+            if (m_gc_phase == GCPhase::sweeping && cell_id >= m_sweep_cursor && !object_cell->has_mark(ObjectMark::marked)) {
+                continue;
+            }
+
+            object_cell->set_mark(ObjectMark::remembered, false);
+            m_promote_stack.emplace_back(object_cell.get());
+        }
+
+        m_remembered.clear();
+    }
+
+    void HeapStorage::forward_gray() noexcept {
+        for (auto& gray_p : m_mark_stack) {
+            if (gray_p->has_mark(ObjectMark::young)) {
+                gray_p = m_nursery_forwards[granule_of(gray_p)];
+            }
+        }
+
+        /// NOTE: Gray young objects without an old copy were unreachable after all.
+        std::erase(m_mark_stack, nullptr);
+    }
+
+    auto HeapStorage::is_unswept_garbage(std::size_t slot_id) const noexcept -> bool {
+        return m_gc_phase == GCPhase::sweeping && slot_id >= m_sweep_cursor && !m_objects[slot_id]->has_mark(ObjectMark::marked);
+    }
+
+    template <typename Fn>
+    void HeapStorage::for_each_resident(Fn&& fn) {
+        for (auto slot_id = 0UL; slot_id < m_next_id; ++slot_id) {
+            if (m_objects[slot_id] && !is_unswept_garbage(slot_id)) {
+                fn(m_objects[slot_id].get(), static_cast<uint64_t>(slot_id));
+            }
+        }
+
+        for (auto offset = 0UL; m_nursery && offset < m_nursery_top;) {
+            HeapValuePtr young_p = nursery_object_at(offset);
+
+            fn(young_p, static_cast<uint64_t>(m_next_id + offset / cm_nursery_granule));
+            offset += young_p->get_size_class() * cm_nursery_granule;
+        }
+    }
+
+    auto HeapStorage::get_objects() noexcept -> std::vector<HeapObjectOwner>& {
         return m_objects;
     }
+
+    auto HeapStorage::take_census(std::size_t largest_count) -> HeapCensus {
+        HeapCensus census {
+            .by_tag = {},
+            .largest_sequences = {},
+            .young_count = 0UL,
+            .dead_count = 0UL,
+            .slot_high_water = m_next_id,
+            .slot_capacity = m_objects.size(),
+            .hole_count = m_hole_list.size(),
+            .longest_hole_run = 0UL,
+            .old_bytes = m_old_bytes,
+            .next_gc_bytes = m_next_gc_bytes,
+            .object_slabs = m_object_slabs->get_stats(),
+            .payload_pool = m_payload_pool->get_stats(),
+        };
+        std::vector<SequenceSummary> sequences;
+
+        for (auto slot_id = 0UL, hole_run = 0UL; slot_id < m_next_id; ++slot_id) {
+            hole_run = (m_objects[slot_id]) ? 0UL : hole_run + 1UL;
+            census.longest_hole_run = std::max(census.longest_hole_run, hole_run);
+
+            if (m_objects[slot_id] && is_unswept_garbage(slot_id)) {
+                ++census.dead_count;
+            }
+        }
+
+        for_each_resident([&census, &sequences](HeapValuePtr object_p, uint64_t object_id) {
+            const auto element_count = static_cast<std::size_t>(object_p->get_size());
+            const auto memory_score = object_p->get_memory_score();
+            const auto young = object_p->has_mark(ObjectMark::young);
+            auto& tag_census = census.by_tag[static_cast<std::size_t>(object_p->get_tag())];
+
+            ++tag_census.object_count;
+            tag_census.element_count += element_count;
+            tag_census.memory_score += memory_score;
+
+            if (young) {
+                ++census.young_count;
+            }
+
+            if (object_p->get_tag() == ObjectTag::sequence) {
+                sequences.emplace_back(SequenceSummary {
+                    .object_id = object_id,
+                    .element_count = element_count,
+                    .memory_score = memory_score,
+                    .young = young,
+                });
+            }
+        });
+
+        const auto kept_count = std::min(largest_count, sequences.size());
+
+        std::partial_sort(sequences.begin(), sequences.begin() + kept_count, sequences.end(), [](const SequenceSummary& lhs, const SequenceSummary& rhs) noexcept {
+            return lhs.memory_score > rhs.memory_score;
+        });
+        sequences.resize(kept_count);
+        census.largest_sequences = std::move(sequences);
+
+        return census;
+    }
+
+    auto HeapStorage::write_snapshot(std::ostream& out, std::span<const HeapValuePtr> roots) -> bool {
+        auto write_field = [&out]<typename Field>(Field field) {
+            out.write(reinterpret_cast<const char*>(&field), sizeof(Field));
+        };
+
+        std::unordered_map<HeapValuePtr, uint64_t> object_ids;
+
+        for_each_resident([&object_ids](HeapValuePtr object_p, uint64_t object_id) {
+            object_ids.emplace(object_p, object_id);
+        });
+
+        std::vector<uint64_t> root_ids;
+
+        for (HeapValuePtr root_p : roots) {
+            if (auto id_it = object_ids.find(root_p); id_it != object_ids.end()) {
+                root_ids.emplace_back(id_it->second);
+            }
+        }
+
+        out.write(Snapshot::magic.data(), static_cast<std::streamsize>(Snapshot::magic.size()));
+        write_field(static_cast<uint64_t>(object_ids.size()));
+        write_field(static_cast<uint64_t>(root_ids.size()));
+
+        for (const auto root_id : root_ids) {
+            write_field(root_id);
+        }
+
+        std::vector<uint64_t> child_ids;
+
+        for_each_resident([&](HeapValuePtr object_p, uint64_t object_id) {
+            uint8_t flags = 0;
+
+            if (object_p->has_mark(ObjectMark::young)) {
+                flags |= static_cast<uint8_t>(Snapshot::ObjectFlag::young);
+            }
+
+            if (object_p->is_frozen()) {
+                flags |= static_cast<uint8_t>(Snapshot::ObjectFlag::frozen);
+            }
+
+            child_ids.clear();
+
+            visit_object(*object_p, [&object_ids, &child_ids](auto& object) {
+                object.visit_children([&object_ids, &child_ids](HeapValuePtr child_p) {
+                    if (auto id_it = object_ids.find(child_p); id_it != object_ids.end()) {
+                        child_ids.emplace_back(id_it->second);
+                    }
+                });
+            });
+
+            write_field(object_id);
+            write_field(static_cast<uint8_t>(object_p->get_tag()));
+            write_field(flags);
+            write_field(uint16_t {0});
+            write_field(static_cast<uint32_t>(object_p->get_size()));
+            write_field(static_cast<uint64_t>(object_p->get_memory_score()));
+            write_field(static_cast<uint32_t>(child_ids.size()));
+            write_field(uint32_t {0});
+
+            for (const auto child_id : child_ids) {
+                write_field(child_id);
+            }
+        });
+
+        out.flush();
+
+        return static_cast<bool>(out);
+    }
 }
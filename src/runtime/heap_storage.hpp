@@ -1,44 +1,230 @@
 #ifndef MINUET_RUNTIME_HEAP_STORAGE_HPP
 #define MINUET_RUNTIME_HEAP_STORAGE_HPP
 
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
-#include <queue>
+#include <span>
 #include <vector>
 
+#include "runtime/heap_allocators.hpp"
+#include "runtime/heap_census.hpp"
 #include "runtime/fast_value.hpp"
 
 namespace Minuet::Runtime {
+    /// NOTE: Destroys a heap object as its concrete type, since `HeapValueBase` has no virtual destructor, then returns its block to the heap's object slabs.
+    struct HeapObjectDeleter {
+        BlockPool* slabs;
+
+        void operator()(HeapValueBase* object_p) const noexcept;
+    };
+
+    /// NOTE: Owning pointer of one heap slot.
+    using HeapObjectOwner = std::unique_ptr<HeapValueBase, HeapObjectDeleter>;
+
+    /// NOTE: Where a full collection stands between the engine's GC steps.
+    enum class GCPhase : uint8_t {
+        idle,
+        marking,  // gray objects wait in the mark stack, & stores shade the objects they write
+        sweeping, // old slots below the sweep cursor are done
+    };
+
+    /**
+     * @brief Owns the VM's heap objects in two generations. New objects are bump-allocated in a fixed nursery, and a minor collection promotes the reachable ones into old slots before reusing the whole nursery. Old objects are only freed by the full mark & sweep, which may run in bounded steps between the mutator's instructions.
+     */
     class HeapStorage {
     private:
-        /// NOTE: stores constant for default memory "capacity" of VM heap
-        static constexpr auto cm_normal_max_overhead = 16384UL;
-        static constexpr auto cm_normal_gc_threshold = 8192UL;
-        static constexpr auto cm_normal_obj_overhead = 16UL;
-        static constexpr auto cm_normal_obj_capacity = cm_normal_max_overhead / cm_normal_obj_overhead;
+        /// NOTE: starting count of old slots, which doubles whenever promotion finds them full
+        static constexpr auto cm_initial_slot_count = 256UL;
+
+        /// NOTE: old generation bytes below which no full collection starts, so that small scripts rarely need one
+        static constexpr auto cm_min_gc_threshold = 65536UL;
+        static constexpr auto cm_default_growth_percent = 200UL;
+
+        /// NOTE: nursery size & the unit of its bump allocations, which matches an object's size class
+        static constexpr auto cm_nursery_bytes = 16384UL;
+        static constexpr auto cm_nursery_granule = 16UL;
+        static constexpr auto cm_nursery_granules = cm_nursery_bytes / cm_nursery_granule;
+
+        /// NOTE: item buffer bytes which young sequences may grow by before a push runs an early minor collection, since a full nursery alone does not bound them
+        static constexpr auto cm_young_payload_budget = 262144UL;
+
+        /// NOTE: old slots below which parallel marking & sweeping cost more in thread startup than they save
+        static constexpr auto cm_parallel_min_slots = 8192UL;
+
+        /// NOTE: blocks of old objects by size class & the item buffers of all sequences. Both live behind pointers, since objects & buffers refer to them across moves of the heap, and are declared first so that they outlive every object.
+        std::unique_ptr<BlockPool> m_object_slabs;
+        std::unique_ptr<BlockPool> m_payload_pool;
+
+        /// NOTE: free list of object slots in the VM "heap" remaining between live slots, reused most recently freed first
+        std::vector<std::size_t> m_hole_list;
 
-        /// NOTE: tracks freed object slots in the VM "heap" remaining between live slots
-        std::queue<std::size_t> m_hole_list;
+        /// NOTE: gray objects of a full collection. Its capacity covers every object, so marking never allocates.
+        std::vector<HeapValuePtr> m_mark_stack;
 
-        /// NOTE: tracks actual object slots (live / unreachable)
-        std::vector<std::unique_ptr<HeapValueBase>> m_objects;
+        /// NOTE: remembered & promoted objects to scan in a minor collection, kept apart from the gray objects of a full collection in progress
+        std::vector<HeapValuePtr> m_promote_stack;
 
-        /// NOTE: holds a null dud for invalid object references
-        std::unique_ptr<HeapValueBase> m_dud;
+        /// NOTE: old sequences which got a young object since the last minor collection, each added once as its `remembered` bit gets set. Dead ones are dropped when sweeping starts, so every entry stays valid.
+        std::vector<HeapValuePtr> m_remembered;
+
+        /// NOTE: tracks actual object slots (live / unreachable) of the old generation
+        std::vector<HeapObjectOwner> m_objects;
+
+        /// NOTE: young generation storage & the promoted copy of each young object by its granule index
+        std::unique_ptr<std::byte[]> m_nursery;
+        std::vector<HeapValuePtr> m_nursery_forwards;
+
+        /// NOTE: old generation bytes as of the last sweep, plus the bytes of each object at its promotion & the growth of old item buffers by pushes since. Young item buffer growth counts separately until the next minor collection.
+        std::size_t m_old_bytes;
+        std::size_t m_next_gc_bytes;
+        std::size_t m_sweep_live_bytes;
+        std::size_t m_growth_percent;
+        std::size_t m_young_payload_bytes;
 
-        std::size_t m_overhead;
         std::size_t m_next_id;
+        std::size_t m_nursery_top;
+        std::size_t m_sweep_cursor;
+
+        GCPhase m_gc_phase;
+
+        /// NOTE: set when a young object is stored through a reference, whose containing sequence is unknown
+        bool m_untracked_stores;
+
+        [[nodiscard]] auto nursery_object_at(std::size_t offset) noexcept -> HeapValuePtr;
+        [[nodiscard]] auto granule_of(HeapValuePtr young_p) const noexcept -> std::size_t;
+        [[nodiscard]] auto claim_old_slot() -> std::size_t;
+        void destroy_nursery() noexcept;
+        void forward_remembered() noexcept;
+        void forward_gray() noexcept;
+        void finish_sweep() noexcept;
+
+        /// NOTE: Whether an old slot holds an object which the ongoing sweep found unreachable but has yet to free.
+        [[nodiscard]] auto is_unswept_garbage(std::size_t slot_id) const noexcept -> bool;
+
+        /// NOTE: Passes each resident object & its snapshot id to `fn`, skipping unswept garbage.
+        template <typename Fn>
+        void for_each_resident(Fn&& fn);
 
     public:
         /// NOTE: preload "heap literals" from IR & codegen stages here!
         HeapStorage();
 
-        [[nodiscard]] auto is_ripe() const& noexcept -> bool;
+        /// NOTE: `growth_percent` scales the live bytes after each full collection into the threshold of the next one, where `0` picks the default of 200.
+        explicit HeapStorage(std::size_t growth_percent);
+        ~HeapStorage();
+
+        HeapStorage(const HeapStorage&) = delete;
+        auto operator=(const HeapStorage&) -> HeapStorage& = delete;
+
+        HeapStorage(HeapStorage&&) noexcept = default;
+        auto operator=(HeapStorage&&) -> HeapStorage& = delete;
+
+        /// NOTE: Gives the bytes which an old object accounts for: its footprint & payload.
+        [[nodiscard]] static auto bytes_of(const HeapValueBase& object) noexcept -> std::size_t;
 
-        [[nodiscard]] auto try_create_value(ObjectTag obj_tag) noexcept -> std::unique_ptr<HeapValueBase>&;
+        [[nodiscard]] auto get_old_bytes() const noexcept -> std::size_t;
+        [[nodiscard]] auto get_next_gc_bytes() const noexcept -> std::size_t;
+
+        /// NOTE: Counters of the old objects' slabs & of the sequence payload pool. Young objects are bump-allocated, so only their payloads count.
+        [[nodiscard]] auto get_object_slab_stats() const noexcept -> AllocatorStats;
+        [[nodiscard]] auto get_payload_pool_stats() const noexcept -> AllocatorStats;
+
+        /// NOTE: Bump-allocates a young object, giving a null object once the nursery is full.
+        [[nodiscard]] auto try_create_value(ObjectTag obj_tag) noexcept -> HeapValuePtr;
 
         [[nodiscard]] auto try_destroy_value(std::size_t id) noexcept -> bool;
 
-        [[nodiscard]] auto get_objects() noexcept -> std::vector<std::unique_ptr<HeapValueBase>>&;
+        [[nodiscard]] auto gc_phase() const noexcept -> GCPhase {
+            return m_gc_phase;
+        }
+
+        /// NOTE: Checked at allocation safepoints: whether a full collection is in progress or the old generation reached its threshold.
+        [[nodiscard]] auto has_gc_work() const noexcept -> bool {
+            return m_gc_phase != GCPhase::idle || m_old_bytes >= m_next_gc_bytes;
+        }
+
+        [[nodiscard]] auto is_nursery_ripe() const noexcept -> bool {
+            return m_young_payload_bytes >= cm_young_payload_budget;
+        }
+
+        /// NOTE: Accounts for the item buffer of `object` growing by `bytes`. An old sequence's growth counts toward the next full collection, and a young one's toward an early minor collection.
+        void note_growth(const HeapValueBase& object, std::size_t bytes) noexcept {
+            if (object.has_mark(ObjectMark::young)) {
+                m_young_payload_bytes += bytes;
+            } else {
+                m_old_bytes += bytes;
+            }
+        }
+
+        /// NOTE: Starts a full collection, after which the engine marks its roots.
+        void begin_marking() noexcept;
+
+        /// NOTE: Marks a root object unless it is already marked, queueing it for `trace_some()`. Young objects are traced too, so old objects which only they reference stay alive.
+        void mark_object(HeapValuePtr object_p) noexcept;
+
+        /// NOTE: Insertion barrier for every store of `value` into a sequence. While marking, the stored object gets shaded so that an already traced sequence cannot hide it.
+        void shade(FastValue value) noexcept {
+            if (m_gc_phase == GCPhase::marking) {
+                if (HeapValuePtr object_p = value.to_object_ptr(); object_p) {
+                    mark_object(object_p);
+                }
+            }
+        }
+
+        /**
+         * @brief Traces up to `budget` gray objects.
+         * @return Whether no gray objects remain.
+         */
+        [[nodiscard]] auto trace_some(std::size_t budget) noexcept -> bool;
+
+        /**
+         * @brief Traces every gray object, sharing the work among `worker_count` threads if the old generation is large enough.
+         * @return Whether the work was shared.
+         */
+        auto trace_all(std::size_t worker_count) -> bool;
+
+        /// NOTE: Ends marking once the roots were marked again & traced: clears the marks of young objects, which only minor collections free, then starts sweeping.
+        void begin_sweep() noexcept;
+
+        /**
+         * @brief Sweeps up to `budget` old slots, freeing each unmarked object into the free list & clearing the marks of the rest. Only slots below the high-water mark are scanned. Once all are done, the survivors' bytes set the threshold of the next collection.
+         * @return Whether the collection is done.
+         */
+        [[nodiscard]] auto sweep_some(std::size_t budget) noexcept -> bool;
+
+        /// NOTE: Sweeps every remaining slot like `trace_all()`, in one slot range per thread, giving whether the work was shared.
+        auto sweep_all(std::size_t worker_count) -> bool;
+
+        /// NOTE: Write barriers for every store of `value` into the sequence `target`: the insertion barrier of `shade()`, and the generational barrier which remembers an old `target` that gets a young object, so that the next minor collection scans it as a root.
+        void note_store(HeapValueBase& target, FastValue value) noexcept {
+            shade(value);
+
+            if (HeapValuePtr child_p = value.to_object_ptr(); child_p != nullptr && child_p->has_mark(ObjectMark::young) && !target.has_mark(ObjectMark::young) && !target.has_mark(ObjectMark::remembered)) {
+                target.set_mark(ObjectMark::remembered, true);
+                m_remembered.emplace_back(&target);
+            }
+        }
+
+        /// NOTE: Write barrier for stores through a `val_ref`, which may put a young object into an old sequence.
+        void note_untracked_store() noexcept;
+
+        /// NOTE: Gives the old copy of a young root, promoting it on first sight. The caller then rewrites the root.
+        [[nodiscard]] auto promote(HeapValuePtr young_p) -> HeapValuePtr;
+
+        /// NOTE: Ends a minor collection after every root was promoted: promotes what remembered & promoted objects reference, then empties the nursery. Gray young objects of a full collection are replaced by their old copies.
+        void finish_minor();
+
+        /// NOTE: Destroys every object but keeps the slot storage for reuse.
+        void reset() noexcept;
+
+        [[nodiscard]] auto get_objects() noexcept -> std::vector<HeapObjectOwner>&;
+
+        /// NOTE: Counts the resident objects & the fragmentation of the old slots, listing up to `largest_count` sequences with the largest payloads.
+        [[nodiscard]] auto take_census(std::size_t largest_count) -> HeapCensus;
+
+        /// NOTE: Writes every resident object & its references in the `Snapshot` layout, where `roots` are the objects held by registers. Gives whether all of it was written.
+        [[nodiscard]] auto write_snapshot(std::ostream& out, std::span<const HeapValuePtr> roots) -> bool;
     };
 }
 
@@ -0,0 +1,814 @@
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "runtime/jit_x64.hpp"
+
+#if MINUET_JIT_X64
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace Minuet::Runtime::JIT {
+    using Code::Opcode;
+    using Code::ArgMode;
+
+    CompiledChunk::CompiledChunk() noexcept
+    : m_base {nullptr}, m_length {0UL}, m_entry {nullptr} {}
+
+    CompiledChunk::CompiledChunk(void* base, std::size_t length, JitEntry entry) noexcept
+    : m_base {base}, m_length {length}, m_entry {entry} {}
+
+    CompiledChunk::CompiledChunk(CompiledChunk&& other) noexcept
+    : m_base {std::exchange(other.m_base, nullptr)}, m_length {std::exchange(other.m_length, 0UL)}, m_entry {std::exchange(other.m_entry, nullptr)} {}
+
+    auto CompiledChunk::operator=(CompiledChunk&& other) noexcept -> CompiledChunk& {
+        if (this != &other) {
+            CompiledChunk old {std::move(*this)};
+
+            m_base = std::exchange(other.m_base, nullptr);
+            m_length = std::exchange(other.m_length, 0UL);
+            m_entry = std::exchange(other.m_entry, nullptr);
+        }
+
+        return *this;
+    }
+
+    CompiledChunk::~CompiledChunk() {
+#if MINUET_JIT_X64
+        if (m_base != nullptr) {
+            munmap(m_base, m_length);
+        }
+#endif
+    }
+
+    auto CompiledChunk::entry() const noexcept -> JitEntry {
+        return m_entry;
+    }
+
+#if MINUET_JIT_X64
+    namespace Utils {
+        enum class Reg : uint8_t {
+            rax = 0,
+            rcx = 1,
+            rdx = 2,
+            rbx = 3, // frame pointer
+            rsp = 4,
+            rbp = 5,
+            rsi = 6,
+            rdi = 7,
+            r12 = 12, // JitContext pointer
+            r13 = 13, // constants pointer
+        };
+
+        /// NOTE: x86 condition codes as used by `jcc` & `setcc`, where flipping the low bit negates a condition.
+        enum class Cond : uint8_t {
+            e = 0x4,
+            ne = 0x5,
+            a = 0x7,
+            l = 0xC,
+            ge = 0xD,
+            le = 0xE,
+            g = 0xF,
+        };
+
+        /// NOTE: Memory operand `[base + disp]`, e.g a register slot off the frame or a constant off the pool.
+        struct Mem {
+            Reg base;
+            int32_t disp;
+        };
+
+        struct Fixup {
+            int at;     // offset of the rel32 field
+            int label;
+            int addend;
+        };
+
+        enum class CompareKind : int {
+            eq,
+            lt,
+            gt,
+            le,
+            ge,
+        };
+
+        [[nodiscard]] constexpr auto negate(Cond cc) noexcept -> Cond {
+            return static_cast<Cond>(static_cast<uint8_t>(cc) ^ 1U);
+        }
+
+        [[nodiscard]] constexpr auto reg_bits(Reg reg) noexcept -> uint8_t {
+            return static_cast<uint8_t>(reg);
+        }
+    }
+
+    using Utils::Reg;
+    using Utils::Cond;
+    using Utils::Mem;
+    using Utils::CompareKind;
+
+    static constexpr int fv_size = sizeof(FastValue);
+    static constexpr int fv_tag_offset = 8;
+    static constexpr uint8_t boolean_tag = static_cast<uint8_t>(FVTag::boolean);
+    static constexpr uint8_t int32_tag = static_cast<uint8_t>(FVTag::int32);
+    static constexpr uint8_t val_ref_tag = static_cast<uint8_t>(FVTag::val_ref);
+
+    static_assert(fv_size == 16, "compiled templates assume a 16-byte FastValue with its tag at byte 8");
+
+    /// NOTE: Slow paths of the compiled templates. These only use `FastValue`'s own operators, so they match the interpreter.
+    static auto jit_truthy(const FastValue* value) noexcept -> bool {
+        return static_cast<bool>(*value);
+    }
+
+    static auto jit_compare(const FastValue* lhs, const FastValue* rhs, int kind) noexcept -> bool {
+        switch (static_cast<CompareKind>(kind)) {
+            case CompareKind::eq: return *lhs == *rhs;
+            case CompareKind::lt: return *lhs < *rhs;
+            case CompareKind::gt: return *lhs > *rhs;
+            case CompareKind::le: return *lhs <= *rhs;
+            case CompareKind::ge: return *lhs >= *rhs;
+            default: return false;
+        }
+    }
+
+    /**
+     * @brief Minimal x86-64 encoder for the templates. All memory operands use a 32-bit displacement, and every jump is `rel32` to a label patched once the chunk is done.
+     */
+    class Assembler {
+    public:
+        Assembler()
+        : m_bytes {}, m_label_pos {}, m_fixups {} {}
+
+        [[nodiscard]] auto new_label() -> int {
+            m_label_pos.push_back(-1);
+
+            return static_cast<int>(m_label_pos.size()) - 1;
+        }
+
+        void bind(int label) noexcept {
+            m_label_pos[label] = size();
+        }
+
+        [[nodiscard]] auto size() const noexcept -> int {
+            return static_cast<int>(m_bytes.size());
+        }
+
+        [[nodiscard]] auto label_pos(int label) const noexcept -> int {
+            return m_label_pos[label];
+        }
+
+        void align(int boundary) {
+            while (size() % boundary != 0) {
+                byte(0xCC);
+            }
+        }
+
+        void byte(uint8_t value) {
+            m_bytes.push_back(value);
+        }
+
+        void dword(uint32_t value) {
+            for (auto shift = 0; shift < 32; shift += 8) {
+                byte(static_cast<uint8_t>(value >> shift));
+            }
+        }
+
+        void qword(uint64_t value) {
+            for (auto shift = 0; shift < 64; shift += 8) {
+                byte(static_cast<uint8_t>(value >> shift));
+            }
+        }
+
+        void raw(const void* data, std::size_t length) {
+            const auto bytes_p = static_cast<const uint8_t*>(data);
+
+            m_bytes.insert(m_bytes.end(), bytes_p, bytes_p + length);
+        }
+
+        /// NOTE: Emits `[REX] opcode... modrm [sib] disp32` where `reg` is either a register or an opcode extension.
+        void op_mem(std::initializer_list<uint8_t> opcode, bool wide, uint8_t reg, Mem mem) {
+            const auto base = Utils::reg_bits(mem.base);
+            const uint8_t rex = 0x40 | (wide ? 0x08 : 0x00) | ((reg >> 3) << 2) | (base >> 3);
+
+            if (rex != 0x40) {
+                byte(rex);
+            }
+
+            for (const auto op_byte : opcode) {
+                byte(op_byte);
+            }
+
+            byte(static_cast<uint8_t>(0x80 | ((reg & 0b111) << 3) | (base & 0b111)));
+
+            if ((base & 0b111) == 0b100) {
+                byte(0x24);
+            }
+
+            dword(static_cast<uint32_t>(mem.disp));
+        }
+
+        void mov_r32_mem(Reg dest, Mem src) { op_mem({0x8B}, false, Utils::reg_bits(dest), src); }
+        void mov_r64_mem(Reg dest, Mem src) { op_mem({0x8B}, true, Utils::reg_bits(dest), src); }
+        void mov_mem_r64(Mem dest, Reg src) { op_mem({0x89}, true, Utils::reg_bits(src), dest); }
+        void add_r32_mem(Reg dest, Mem src) { op_mem({0x03}, false, Utils::reg_bits(dest), src); }
+        void sub_r32_mem(Reg dest, Mem src) { op_mem({0x2B}, false, Utils::reg_bits(dest), src); }
+        void imul_r32_mem(Reg dest, Mem src) { op_mem({0x0F, 0xAF}, false, Utils::reg_bits(dest), src); }
+        void cmp_r32_mem(Reg lhs, Mem rhs) { op_mem({0x3B}, false, Utils::reg_bits(lhs), rhs); }
+        void add_mem_r32(Mem dest, Reg src) { op_mem({0x01}, false, Utils::reg_bits(src), dest); }
+        void sub_mem_r32(Mem dest, Reg src) { op_mem({0x29}, false, Utils::reg_bits(src), dest); }
+        void lea_r64_mem(Reg dest, Mem src) { op_mem({0x8D}, true, Utils::reg_bits(dest), src); }
+
+        void cmp_mem8_imm8(Mem lhs, uint8_t imm) {
+            op_mem({0x80}, false, 7, lhs);
+            byte(imm);
+        }
+
+        void mov_mem8_imm8(Mem dest, uint8_t imm) {
+            op_mem({0xC6}, false, 0, dest);
+            byte(imm);
+        }
+
+        void cmp_mem32_imm8(Mem lhs, int8_t imm) {
+            op_mem({0x83}, false, 7, lhs);
+            byte(static_cast<uint8_t>(imm));
+        }
+
+        void add_mem32_imm8(Mem dest, int8_t imm) {
+            op_mem({0x83}, false, 0, dest);
+            byte(static_cast<uint8_t>(imm));
+        }
+
+        void sub_mem64_imm32(Mem dest, int32_t imm) {
+            op_mem({0x81}, true, 5, dest);
+            dword(static_cast<uint32_t>(imm));
+        }
+
+        /// NOTE: `movzx eax, byte [mem]` for reading a value's tag.
+        void movzx_eax_mem8(Mem src) { op_mem({0x0F, 0xB6}, false, 0, src); }
+
+        void mov_r64_r64(Reg dest, Reg src) {
+            const auto dest_bits = Utils::reg_bits(dest);
+            const auto src_bits = Utils::reg_bits(src);
+
+            byte(static_cast<uint8_t>(0x48 | ((src_bits >> 3) << 2) | (dest_bits >> 3)));
+            byte(0x89);
+            byte(static_cast<uint8_t>(0xC0 | ((src_bits & 0b111) << 3) | (dest_bits & 0b111)));
+        }
+
+        void mov_r64_imm64(Reg dest, uint64_t imm) {
+            const auto dest_bits = Utils::reg_bits(dest);
+
+            byte(static_cast<uint8_t>(0x48 | (dest_bits >> 3)));
+            byte(static_cast<uint8_t>(0xB8 + (dest_bits & 0b111)));
+            qword(imm);
+        }
+
+        void mov_r32_imm32(Reg dest, int32_t imm) {
+            const auto dest_bits = Utils::reg_bits(dest);
+
+            if (dest_bits >= 8) {
+                byte(0x41);
+            }
+
+            byte(static_cast<uint8_t>(0xB8 + (dest_bits & 0b111)));
+            dword(static_cast<uint32_t>(imm));
+        }
+
+        /// NOTE: `lea reg, [rip + label + addend]`
+        void lea_r64_rip(Reg dest, int label, int addend) {
+            const auto dest_bits = Utils::reg_bits(dest);
+
+            byte(static_cast<uint8_t>(0x48 | ((dest_bits >> 3) << 2)));
+            byte(0x8D);
+            byte(static_cast<uint8_t>(0x05 | ((dest_bits & 0b111) << 3)));
+            rel32(label, addend);
+        }
+
+        void push(Reg reg) {
+            const auto reg_bits = Utils::reg_bits(reg);
+
+            if (reg_bits >= 8) {
+                byte(0x41);
+            }
+
+            byte(static_cast<uint8_t>(0x50 + (reg_bits & 0b111)));
+        }
+
+        void pop(Reg reg) {
+            const auto reg_bits = Utils::reg_bits(reg);
+
+            if (reg_bits >= 8) {
+                byte(0x41);
+            }
+
+            byte(static_cast<uint8_t>(0x58 + (reg_bits & 0b111)));
+        }
+
+        void call_rax() {
+            byte(0xFF);
+            byte(0xD0);
+        }
+
+        void ret() {
+            byte(0xC3);
+        }
+
+        void test_al_al() {
+            byte(0x84);
+            byte(0xC0);
+        }
+
+        /// NOTE: `setcc al` then `movzx eax, al`
+        void set_eax(Cond cc) {
+            byte(0x0F);
+            byte(static_cast<uint8_t>(0x90 + static_cast<uint8_t>(cc)));
+            byte(0xC0);
+            byte(0x0F);
+            byte(0xB6);
+            byte(0xC0);
+        }
+
+        /// NOTE: `sub eax, 1` then `cmp eax, 1`, so that `ja` rejects any tag other than `boolean, int32`.
+        void check_scalar_tag_eax() {
+            static_assert(boolean_tag + 1 == int32_tag);
+
+            byte(0x83);
+            byte(0xE8);
+            byte(boolean_tag);
+            byte(0x83);
+            byte(0xF8);
+            byte(0x01);
+        }
+
+        void jmp(int label) {
+            byte(0xE9);
+            rel32(label, 0);
+        }
+
+        void jcc(Cond cc, int label) {
+            byte(0x0F);
+            byte(static_cast<uint8_t>(0x80 + static_cast<uint8_t>(cc)));
+            rel32(label, 0);
+        }
+
+        /// NOTE: `movsxd rdx, edx` then `jmp [rax + rdx * 8]` through the IP table.
+        void jmp_table_rax_rdx() {
+            byte(0x48);
+            byte(0x63);
+            byte(0xD2);
+            byte(0xFF);
+            byte(0x24);
+            byte(0xD0);
+        }
+
+        [[nodiscard]] auto finish() -> std::vector<uint8_t> {
+            for (const auto& [at, label, addend] : m_fixups) {
+                const auto rel_value = static_cast<int32_t>(m_label_pos[label] + addend - (at + 4));
+
+                std::memcpy(m_bytes.data() + at, &rel_value, sizeof(rel_value));
+            }
+
+            return std::move(m_bytes);
+        }
+
+    private:
+        void rel32(int label, int addend) {
+            m_fixups.emplace_back(Utils::Fixup {
+                .at = size(),
+                .label = label,
+                .addend = addend,
+            });
+            dword(0);
+        }
+
+        std::vector<uint8_t> m_bytes;
+        std::vector<int> m_label_pos;
+        std::vector<Utils::Fixup> m_fixups;
+    };
+
+    /**
+     * @brief Emits the templates of one chunk. The compiled function keeps the frame in `rbx`, the `JitContext` in `r12`, and the constants in `r13`.
+     */
+    class ChunkCompiler {
+    public:
+        ChunkCompiler(const Code::Chunk& chunk, JitStepFn step_fn)
+        : m_asm {}, m_chunk {chunk}, m_ip_labels {}, m_step_fn {step_fn}, m_exit_label {}, m_table_label {}, m_insts_label {} {}
+
+        [[nodiscard]] auto operator()() -> std::vector<uint8_t> {
+            const int chunk_len = m_chunk.size();
+
+            for (auto ip = 0; ip <= chunk_len; ++ip) {
+                m_ip_labels.push_back(m_asm.new_label());
+            }
+
+            m_exit_label = m_asm.new_label();
+            m_table_label = m_asm.new_label();
+            m_insts_label = m_asm.new_label();
+
+            emit_prologue();
+
+            for (auto ip = 0; ip < chunk_len; ++ip) {
+                m_asm.bind(m_ip_labels[ip]);
+                emit_instruction(ip, m_chunk[ip]);
+            }
+
+            /// NOTE: Running off the chunk's end leaves the interpreter at the same bad IP as it would be anyways.
+            m_asm.bind(m_ip_labels[chunk_len]);
+            emit_exit(chunk_len);
+
+            m_asm.bind(m_exit_label);
+            m_asm.pop(Reg::r13);
+            m_asm.pop(Reg::r12);
+            m_asm.pop(Reg::rbx);
+            m_asm.ret();
+
+            /// NOTE: The IP table is filled with absolute addresses once the code's final address is known.
+            m_asm.align(8);
+            m_asm.bind(m_table_label);
+
+            for (auto ip = 0; ip <= chunk_len; ++ip) {
+                m_asm.qword(0);
+            }
+
+            m_asm.bind(m_insts_label);
+            m_asm.raw(m_chunk.data(), m_chunk.size() * sizeof(Code::Instruction));
+
+            return m_asm.finish();
+        }
+
+        [[nodiscard]] auto table_offset() const noexcept -> int {
+            return m_asm.label_pos(m_table_label);
+        }
+
+        [[nodiscard]] auto ip_offset(int ip) const noexcept -> int {
+            return m_asm.label_pos(m_ip_labels[ip]);
+        }
+
+    private:
+        [[nodiscard]] static auto frame_slot(int16_t reg_id) noexcept -> Mem {
+            return {.base = Reg::rbx, .disp = reg_id * fv_size};
+        }
+
+        [[nodiscard]] static auto tag_of(Mem value) noexcept -> Mem {
+            return {.base = value.base, .disp = value.disp + fv_tag_offset};
+        }
+
+        [[nodiscard]] static auto hi_of(Mem value) noexcept -> Mem {
+            return {.base = value.base, .disp = value.disp + 8};
+        }
+
+        /// NOTE: Resolves an operand's location at compile time, since each instruction's `ArgMode`s are fixed.
+        [[nodiscard]] static auto operand_at(const Code::Instruction& inst, int arg_pos) noexcept -> std::optional<Mem> {
+            const auto mode = static_cast<ArgMode>((inst.metadata >> (2 + 4 * arg_pos)) & 0b1111);
+
+            switch (mode) {
+                case ArgMode::reg: return Mem {.base = Reg::rbx, .disp = inst.args[arg_pos] * fv_size};
+                case ArgMode::constant: return Mem {.base = Reg::r13, .disp = inst.args[arg_pos] * fv_size};
+                default: return {};
+            }
+        }
+
+        void emit_prologue() {
+            m_asm.push(Reg::rbx);
+            m_asm.push(Reg::r12);
+            m_asm.push(Reg::r13);
+            m_asm.mov_r64_r64(Reg::r12, Reg::rdi);
+            m_asm.mov_r64_r64(Reg::rbx, Reg::rsi);
+            m_asm.mov_r64_mem(Reg::r13, {.base = Reg::r12, .disp = offsetof(JitContext, consts)});
+            m_asm.lea_r64_rip(Reg::rax, m_table_label, 0);
+            m_asm.jmp_table_rax_rdx();
+        }
+
+        void emit_exit(int ip) {
+            m_asm.mov_r32_imm32(Reg::rax, ip);
+            m_asm.jmp(m_exit_label);
+        }
+
+        /// NOTE: A taken backward jump charges the tick window like the interpreter does, leaving to it at the target once the window is spent.
+        void emit_goto(int from_ip, int target_ip) {
+            if (target_ip < 0 || target_ip > static_cast<int>(m_chunk.size())) {
+                emit_exit(from_ip);
+                return;
+            }
+
+            if (target_ip <= from_ip) {
+                m_asm.sub_mem64_imm32({.base = Reg::r12, .disp = offsetof(JitContext, ticks_left)}, from_ip - target_ip + 1);
+                m_asm.jcc(Cond::g, m_ip_labels[target_ip]);
+                emit_exit(target_ip);
+                return;
+            }
+
+            m_asm.jmp(m_ip_labels[target_ip]);
+        }
+
+        void emit_call_helper(uint64_t helper_address) {
+            m_asm.mov_r64_imm64(Reg::rax, helper_address);
+            m_asm.call_rax();
+        }
+
+        /// NOTE: Runs the instruction through the engine's own handler, leaving to the interpreter if it failed.
+        void emit_step(int ip) {
+            const auto ok_label = m_asm.new_label();
+
+            m_asm.mov_r64_mem(Reg::rdi, {.base = Reg::r12, .disp = offsetof(JitContext, engine)});
+            m_asm.mov_r64_r64(Reg::rsi, Reg::rbx);
+            m_asm.lea_r64_rip(Reg::rdx, m_insts_label, ip * static_cast<int>(sizeof(Code::Instruction)));
+            emit_call_helper(reinterpret_cast<uint64_t>(m_step_fn));
+            m_asm.test_al_al();
+            m_asm.jcc(Cond::ne, ok_label);
+            emit_exit(ip);
+            m_asm.bind(ok_label);
+        }
+
+        void emit_copy(Mem dest, Mem src) {
+            m_asm.mov_r64_mem(Reg::rax, src);
+            m_asm.mov_mem_r64(dest, Reg::rax);
+            m_asm.mov_r64_mem(Reg::rax, hi_of(src));
+            m_asm.mov_mem_r64(hi_of(dest), Reg::rax);
+        }
+
+        void emit_int32_guard(Mem value, int slow_label) {
+            m_asm.cmp_mem8_imm8(tag_of(value), int32_tag);
+            m_asm.jcc(Cond::ne, slow_label);
+        }
+
+        void emit_mov(int ip, const Code::Instruction& inst) {
+            const auto src_opt = operand_at(inst, 1);
+
+            if (!src_opt) {
+                emit_step(ip);
+                return;
+            }
+
+            const auto dest = frame_slot(inst.args[0]);
+            const auto slow_label = m_asm.new_label();
+            const auto done_label = m_asm.new_label();
+
+            /// NOTE: A `val_ref` destination writes through to the referenced item, which is left to the handler.
+            m_asm.cmp_mem8_imm8(tag_of(dest), val_ref_tag);
+            m_asm.jcc(Cond::e, slow_label);
+            emit_copy(dest, *src_opt);
+            m_asm.jmp(done_label);
+            m_asm.bind(slow_label);
+            emit_step(ip);
+            m_asm.bind(done_label);
+        }
+
+        void emit_step_one(int ip, const Code::Instruction& inst, int8_t delta) {
+            const auto dest = frame_slot(inst.args[0]);
+            const auto slow_label = m_asm.new_label();
+            const auto done_label = m_asm.new_label();
+
+            emit_int32_guard(dest, slow_label);
+            m_asm.add_mem32_imm8(dest, delta);
+            m_asm.jmp(done_label);
+            m_asm.bind(slow_label);
+            emit_step(ip);
+            m_asm.bind(done_label);
+        }
+
+        void emit_compound_assign(int ip, const Code::Instruction& inst, bool adding) {
+            const auto src_opt = operand_at(inst, 1);
+
+            if (!src_opt) {
+                emit_step(ip);
+                return;
+            }
+
+            const auto dest = frame_slot(inst.args[0]);
+            const auto slow_label = m_asm.new_label();
+            const auto done_label = m_asm.new_label();
+
+            emit_int32_guard(dest, slow_label);
+            emit_int32_guard(*src_opt, slow_label);
+            m_asm.mov_r32_mem(Reg::rax, *src_opt);
+
+            if (adding) {
+                m_asm.add_mem_r32(dest, Reg::rax);
+            } else {
+                m_asm.sub_mem_r32(dest, Reg::rax);
+            }
+
+            m_asm.jmp(done_label);
+            m_asm.bind(slow_label);
+            emit_step(ip);
+            m_asm.bind(done_label);
+        }
+
+        /// NOTE: `dest = lhs op rhs` with an inline int32 path, which wraps around like the interpreter's int32 arithmetic.
+        void emit_arith(int ip, const Code::Instruction& inst, Opcode generic_op) {
+            const auto lhs_opt = operand_at(inst, 1);
+            const auto rhs_opt = operand_at(inst, 2);
+
+            if (!lhs_opt || !rhs_opt) {
+                emit_step(ip);
+                return;
+            }
+
+            const auto dest = frame_slot(inst.args[0]);
+            const auto slow_label = m_asm.new_label();
+            const auto done_label = m_asm.new_label();
+
+            emit_int32_guard(*lhs_opt, slow_label);
+            emit_int32_guard(*rhs_opt, slow_label);
+            m_asm.mov_r32_mem(Reg::rax, *lhs_opt);
+
+            switch (generic_op) {
+                case Opcode::add: m_asm.add_r32_mem(Reg::rax, *rhs_opt); break;
+                case Opcode::sub: m_asm.sub_r32_mem(Reg::rax, *rhs_opt); break;
+                default: m_asm.imul_r32_mem(Reg::rax, *rhs_opt); break;
+            }
+
+            m_asm.mov_mem_r64(dest, Reg::rax);
+            m_asm.mov_mem8_imm8(tag_of(dest), int32_tag);
+            m_asm.jmp(done_label);
+            m_asm.bind(slow_label);
+            emit_step(ip);
+            m_asm.bind(done_label);
+        }
+
+        void emit_compare(int ip, const Code::Instruction& inst, Cond cc) {
+            const auto lhs_opt = operand_at(inst, 1);
+            const auto rhs_opt = operand_at(inst, 2);
+
+            if (!lhs_opt || !rhs_opt) {
+                emit_step(ip);
+                return;
+            }
+
+            const auto dest = frame_slot(inst.args[0]);
+            const auto slow_label = m_asm.new_label();
+            const auto done_label = m_asm.new_label();
+
+            emit_int32_guard(*lhs_opt, slow_label);
+            emit_int32_guard(*rhs_opt, slow_label);
+            m_asm.mov_r32_mem(Reg::rax, *lhs_opt);
+            m_asm.cmp_r32_mem(Reg::rax, *rhs_opt);
+            m_asm.set_eax(cc);
+            m_asm.mov_mem_r64(dest, Reg::rax);
+            m_asm.mov_mem8_imm8(tag_of(dest), boolean_tag);
+            m_asm.jmp(done_label);
+            m_asm.bind(slow_label);
+            emit_step(ip);
+            m_asm.bind(done_label);
+        }
+
+        void emit_cond_jump(int ip, const Code::Instruction& inst, bool jump_if_true) {
+            const auto cond = frame_slot(inst.args[0]);
+            const auto slow_label = m_asm.new_label();
+            const auto take_label = m_asm.new_label();
+            const auto fall_label = m_asm.new_label();
+
+            m_asm.movzx_eax_mem8(tag_of(cond));
+            m_asm.check_scalar_tag_eax();
+            m_asm.jcc(Cond::a, slow_label);
+            m_asm.cmp_mem32_imm8(cond, 0);
+            m_asm.jcc(jump_if_true ? Cond::e : Cond::ne, fall_label);
+            m_asm.jmp(take_label);
+
+            m_asm.bind(slow_label);
+            m_asm.lea_r64_mem(Reg::rdi, cond);
+            emit_call_helper(reinterpret_cast<uint64_t>(&jit_truthy));
+            m_asm.test_al_al();
+            m_asm.jcc(jump_if_true ? Cond::e : Cond::ne, fall_label);
+
+            m_asm.bind(take_label);
+            emit_goto(ip, inst.args[1]);
+            m_asm.bind(fall_label);
+        }
+
+        /// NOTE: Fused branches jump when `(lhs op rhs) != negated`, which the int32 path checks with one `cmp`. Other operand modes skip that path for the generic compare, reading them from the frame like the interpreter's `operand_of()`, so the loop stays in compiled code.
+        void emit_fused_branch(int ip, const Code::Instruction& inst, Cond cc, CompareKind kind, bool negated) {
+            const auto lhs_opt = operand_at(inst, 0);
+            const auto rhs_opt = operand_at(inst, 1);
+            const auto lhs = lhs_opt.value_or(frame_slot(inst.args[0]));
+            const auto rhs = rhs_opt.value_or(frame_slot(inst.args[1]));
+
+            const auto slow_label = m_asm.new_label();
+            const auto take_label = m_asm.new_label();
+            const auto fall_label = m_asm.new_label();
+
+            if (lhs_opt && rhs_opt) {
+                emit_int32_guard(lhs, slow_label);
+                emit_int32_guard(rhs, slow_label);
+                m_asm.mov_r32_mem(Reg::rax, lhs);
+                m_asm.cmp_r32_mem(Reg::rax, rhs);
+                m_asm.jcc(negated ? cc : Utils::negate(cc), fall_label);
+                m_asm.jmp(take_label);
+            }
+
+            m_asm.bind(slow_label);
+            m_asm.lea_r64_mem(Reg::rdi, lhs);
+            m_asm.lea_r64_mem(Reg::rsi, rhs);
+            m_asm.mov_r32_imm32(Reg::rdx, static_cast<int32_t>(kind));
+            emit_call_helper(reinterpret_cast<uint64_t>(&jit_compare));
+            m_asm.test_al_al();
+            m_asm.jcc(negated ? Cond::ne : Cond::e, fall_label);
+
+            m_asm.bind(take_label);
+            emit_goto(ip, inst.args[2]);
+            m_asm.bind(fall_label);
+        }
+
+        void emit_instruction(int ip, const Code::Instruction& inst) {
+            const auto generic_op = Code::generic_opcode(inst.op);
+
+            switch (generic_op) {
+                case Opcode::nop:
+                    break;
+                case Opcode::load_const:
+                    emit_copy(frame_slot(inst.args[0]), {.base = Reg::r13, .disp = inst.args[1] * fv_size});
+                    break;
+                case Opcode::mov: emit_mov(ip, inst); break;
+                case Opcode::inc: emit_step_one(ip, inst, 1); break;
+                case Opcode::dec: emit_step_one(ip, inst, -1); break;
+                case Opcode::add_assign: emit_compound_assign(ip, inst, true); break;
+                case Opcode::sub_assign: emit_compound_assign(ip, inst, false); break;
+                case Opcode::mul:
+                case Opcode::add:
+                case Opcode::sub:
+                    emit_arith(ip, inst, generic_op);
+                    break;
+                case Opcode::equ: emit_compare(ip, inst, Cond::e); break;
+                case Opcode::neq: emit_compare(ip, inst, Cond::ne); break;
+                case Opcode::lt: emit_compare(ip, inst, Cond::l); break;
+                case Opcode::gt: emit_compare(ip, inst, Cond::g); break;
+                case Opcode::lte: emit_compare(ip, inst, Cond::le); break;
+                case Opcode::gte: emit_compare(ip, inst, Cond::ge); break;
+                case Opcode::jump: emit_goto(ip, inst.args[0]); break;
+                case Opcode::jump_if: emit_cond_jump(ip, inst, true); break;
+                case Opcode::jump_else: emit_cond_jump(ip, inst, false); break;
+                case Opcode::jeq: emit_fused_branch(ip, inst, Cond::e, CompareKind::eq, false); break;
+                case Opcode::jne: emit_fused_branch(ip, inst, Cond::e, CompareKind::eq, true); break;
+                case Opcode::jlt: emit_fused_branch(ip, inst, Cond::l, CompareKind::lt, false); break;
+                case Opcode::jgt: emit_fused_branch(ip, inst, Cond::g, CompareKind::gt, false); break;
+                case Opcode::jle: emit_fused_branch(ip, inst, Cond::le, CompareKind::le, false); break;
+                case Opcode::jge: emit_fused_branch(ip, inst, Cond::ge, CompareKind::ge, false); break;
+                case Opcode::jnlt: emit_fused_branch(ip, inst, Cond::l, CompareKind::lt, true); break;
+                case Opcode::jngt: emit_fused_branch(ip, inst, Cond::g, CompareKind::gt, true); break;
+                case Opcode::jnle: emit_fused_branch(ip, inst, Cond::le, CompareKind::le, true); break;
+                case Opcode::jnge: emit_fused_branch(ip, inst, Cond::ge, CompareKind::ge, true); break;
+                /// NOTE: These change frames or tasks, so the interpreter runs them.
+                case Opcode::call:
+                case Opcode::tail_call:
+                case Opcode::spawn:
+                case Opcode::yield:
+                case Opcode::ret:
+                case Opcode::halt:
+                    emit_exit(ip);
+                    break;
+                default:
+                    emit_step(ip);
+                    break;
+            }
+        }
+
+        Assembler m_asm;
+        const Code::Chunk& m_chunk;
+        std::vector<int> m_ip_labels;
+        JitStepFn m_step_fn;
+        int m_exit_label;
+        int m_table_label;
+        int m_insts_label;
+    };
+
+    auto compile_chunk(const Code::Chunk& chunk, JitStepFn step_fn) -> std::optional<CompiledChunk> {
+        if (chunk.empty() || step_fn == nullptr) {
+            return {};
+        }
+
+        ChunkCompiler compiler {chunk, step_fn};
+        auto code_bytes = compiler();
+
+        const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const auto map_length = (code_bytes.size() + page_size - 1) / page_size * page_size;
+        void* map_base = mmap(nullptr, map_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (map_base == MAP_FAILED) {
+            return {};
+        }
+
+        const auto base_address = reinterpret_cast<uint64_t>(map_base);
+        const auto table_offset = compiler.table_offset();
+
+        for (auto ip = 0; ip <= static_cast<int>(chunk.size()); ++ip) {
+            const uint64_t ip_address = base_address + compiler.ip_offset(ip);
+
+            std::memcpy(code_bytes.data() + table_offset + ip * sizeof(uint64_t), &ip_address, sizeof(ip_address));
+        }
+
+        std::memcpy(map_base, code_bytes.data(), code_bytes.size());
+
+        if (mprotect(map_base, map_length, PROT_READ | PROT_EXEC) != 0) {
+            munmap(map_base, map_length);
+            return {};
+        }
+
+        return CompiledChunk {map_base, map_length, reinterpret_cast<JitEntry>(map_base)};
+    }
+#else
+    auto compile_chunk([[maybe_unused]] const Code::Chunk& chunk, [[maybe_unused]] JitStepFn step_fn) -> std::optional<CompiledChunk> {
+        return {};
+    }
+#endif
+}
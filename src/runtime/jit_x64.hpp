@@ -0,0 +1,71 @@
+#ifndef MINUET_RUNTIME_JIT_X64_HPP
+#define MINUET_RUNTIME_JIT_X64_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "runtime/fast_value.hpp"
+#include "runtime/bytecode.hpp"
+
+/// NOTE: The compiled templates hard-code the 16-byte tagged layout of FastValue, so NaN-boxed builds stay interpreted.
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__)) && !MINUET_NAN_BOXING
+    #define MINUET_JIT_X64 1
+#else
+    #define MINUET_JIT_X64 0
+#endif
+
+namespace Minuet::Runtime::JIT {
+    /// NOTE: State shared between the dispatch loop and compiled code. Compiled code addresses these fields by their fixed offsets.
+    struct JitContext {
+        int64_t ticks_left; // the dispatch loop's tick window, charged by compiled back-edges
+        void* engine;       // passed back to the step hook
+        const FastValue* consts;
+    };
+
+    static_assert(offsetof(JitContext, ticks_left) == 0);
+    static_assert(offsetof(JitContext, engine) == 8);
+    static_assert(offsetof(JitContext, consts) == 16);
+
+    /// NOTE: Runs a compiled chunk on a register frame from `start_ip`, returning the IP of the instruction which the interpreter must run next.
+    using JitEntry = int (*)(JitContext* ctx, FastValue* frame, int start_ip);
+
+    /// NOTE: Runs one instruction through the engine's handlers, returning `false` if it set an error status.
+    using JitStepFn = bool (*)(void* engine, FastValue* frame, const Code::Instruction* inst);
+
+    /**
+     * @brief Owns the executable mapping of one compiled chunk.
+     */
+    class CompiledChunk {
+    private:
+        void* m_base;
+        std::size_t m_length;
+        JitEntry m_entry;
+
+    public:
+        CompiledChunk() noexcept;
+        CompiledChunk(void* base, std::size_t length, JitEntry entry) noexcept;
+
+        CompiledChunk(const CompiledChunk&) = delete;
+        auto operator=(const CompiledChunk&) -> CompiledChunk& = delete;
+
+        CompiledChunk(CompiledChunk&& other) noexcept;
+        auto operator=(CompiledChunk&& other) noexcept -> CompiledChunk&;
+
+        ~CompiledChunk();
+
+        [[nodiscard]] auto entry() const noexcept -> JitEntry;
+    };
+
+    [[nodiscard]] constexpr auto is_supported() noexcept -> bool {
+        return MINUET_JIT_X64 != 0;
+    }
+
+    /**
+     * @brief Translates a chunk into x86-64 code, one template per instruction. Simple int32 arithmetic, compares, moves, and jumps run inline, while other instructions call `step_fn`. Calls, returns, spawns, yields, and halts go back to the interpreter.
+     * @return The compiled chunk, or `std::nullopt` on unsupported targets or if no executable memory is available.
+     */
+    [[nodiscard]] auto compile_chunk(const Code::Chunk& chunk, JitStepFn step_fn) -> std::optional<CompiledChunk>;
+}
+
+#endif
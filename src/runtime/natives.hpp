@@ -3,6 +3,7 @@
 
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Minuet::Runtime::VM {
@@ -12,13 +13,14 @@ namespace Minuet::Runtime::VM {
 namespace Minuet::Runtime {
     using native_proc_t = bool (*)(VM::Engine& vm, int16_t argc);
 
-    /// NOTE: Only pass C-string literals to name_str, since they will be used to construct names of native procedure mappings as owning `std::string` objects.
+    /// NOTE: Only pass C-string literals to name_str, since they will be used to construct names of native procedure mappings as owning `std::string` objects. An `inlinable` procedure promises the stock behavior of a builtin which the IR converter may lower to dedicated opcodes, e.g `len_of` to `seq_len`.
     struct NativeProcItem {
         std::string_view name_str;
         native_proc_t proc_ptr;
+        bool inlinable;
 
-        constexpr NativeProcItem(std::string_view name, native_proc_t fn_ptr) noexcept
-        : name_str {name}, proc_ptr {fn_ptr} {}
+        constexpr NativeProcItem(std::string_view name, native_proc_t fn_ptr, bool inlinable_flag = false) noexcept
+        : name_str {name}, proc_ptr {fn_ptr}, inlinable {inlinable_flag} {}
 
         /**
          * @brief This overload is used for validation purposes only... Only a fully set name & function pointer pair is valid for the interpreter `Driver`.
@@ -30,6 +32,7 @@ namespace Minuet::Runtime {
     };
 
     using NativeProcRegistry = std::unordered_map<std::string, int>;
+    using NativeInlineNames = std::unordered_set<std::string>;
     using NativeProcTable = std::vector<native_proc_t>;
 }
 
@@ -4,35 +4,11 @@
 #include "runtime/sequence_value.hpp"
 
 namespace Minuet::Runtime {
-    SequenceValue::SequenceValue()
-    : m_items {}, m_length {0}, m_frozen {false} {}
-
-    auto SequenceValue::items() noexcept -> std::vector<FastValue>& {
-        return m_items;
-    }
-
+    SequenceValue::SequenceValue(BlockPool* payload_pool) noexcept
+    : HeapValueBase {cm_tag, sizeof(SequenceValue)}, m_items (PayloadAllocator<FastValue> {payload_pool}), m_length {0}, m_frozen {false} {}
 
     auto SequenceValue::get_memory_score() const& noexcept -> std::size_t {
-        return m_length * cm_fast_val_memsize;
-    }
-
-    auto SequenceValue::get_tag() const& noexcept -> ObjectTag {
-        return ObjectTag::sequence;
-    }
-
-    auto SequenceValue::get_size() const& noexcept -> int {
-        return m_length;
-    }
-
-    auto SequenceValue::is_frozen() const& noexcept -> bool {
-        return m_frozen;
-    }
-
-    auto SequenceValue::push_value(FastValue arg) -> bool {
-        m_items.emplace_back(std::move(arg));
-        ++m_length;
-
-        return true;
+        return m_items.capacity() * cm_fast_val_memsize;
     }
 
     auto SequenceValue::pop_value(SequenceOpPolicy mode) -> FastValue {
@@ -61,14 +37,6 @@ namespace Minuet::Runtime {
         return true;
     }
 
-    auto SequenceValue::get_value(std::size_t pos) -> std::optional<FastValue*> {
-        if (pos >= 0 && pos < m_items.size()) {
-            return &m_items[pos];
-        }
-
-        return {};
-    }
-
     void SequenceValue::freeze() noexcept {
         m_frozen = true;
     }
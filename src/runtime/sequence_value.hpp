@@ -11,33 +11,79 @@ namespace Minuet::Runtime {
     /**
      * @brief Contains an index to FastValue map to simulate an array.
      */
-    class SequenceValue : public HeapValueBase {
+    class SequenceValue final : public HeapValueBase {
     private:
-        static constexpr auto cm_fast_val_memsize = 16UL;
+        static constexpr auto cm_fast_val_memsize = sizeof(FastValue);
 
-        std::vector<FastValue> m_items;
+        ItemVector m_items;
         int m_length;
         bool m_frozen;
 
     public:
-        SequenceValue();
+        static constexpr auto cm_tag = ObjectTag::sequence;
 
-        [[nodiscard]] auto items() noexcept -> std::vector<FastValue>& override;
+        /// NOTE: The item buffer comes from `payload_pool`, or from `operator new` if it is null.
+        explicit SequenceValue(BlockPool* payload_pool) noexcept;
 
-        [[nodiscard]] auto get_memory_score() const& noexcept -> std::size_t override;
-        [[nodiscard]] auto get_tag() const& noexcept -> ObjectTag override;
-        [[nodiscard]] auto get_size() const& noexcept -> int override;
-        [[nodiscard]] auto is_frozen() const& noexcept -> bool override;
+        /// NOTE: The VM's sequence handlers & the collector call these accessors directly after dispatching on the tag, so they stay inline.
+        [[nodiscard]] auto items() noexcept -> ItemVector& {
+            return m_items;
+        }
 
-        [[nodiscard]] auto push_value(FastValue arg) -> bool override;
-        [[nodiscard]] auto pop_value(SequenceOpPolicy mode) -> FastValue override;
-        [[nodiscard]] auto set_value(FastValue arg, std::size_t pos) -> bool override;
-        [[nodiscard]] auto get_value(std::size_t pos) -> std::optional<FastValue*> override;
+        [[nodiscard]] auto get_size() const& noexcept -> int {
+            return m_length;
+        }
 
-        void freeze() noexcept override;
+        [[nodiscard]] auto is_frozen() const& noexcept -> bool {
+            return m_frozen;
+        }
 
-        [[nodiscard]] auto as_fast_value() noexcept -> FastValue override;
-        [[nodiscard]] auto to_string() const& noexcept -> std::string override;
+        /// NOTE: Stores skip the write barriers, so callers run `HeapStorage::note_store()` first.
+        [[nodiscard]] auto push_value(FastValue arg) -> bool {
+            m_items.emplace_back(arg);
+            ++m_length;
+
+            return true;
+        }
+
+        [[nodiscard]] auto get_value(std::size_t pos) -> std::optional<FastValue*> {
+            if (pos < m_items.size()) {
+                return &m_items[pos];
+            }
+
+            return {};
+        }
+
+        /// NOTE: Passes each object referenced by an item to `fn`, which is how the collector traces through this object.
+        template <typename Fn>
+        void visit_children(Fn&& fn) {
+            for (auto& item : m_items) {
+                if (HeapValuePtr child_p = item.to_object_ptr(); child_p != nullptr) {
+                    fn(child_p);
+                }
+            }
+        }
+
+        /// NOTE: Replaces each referenced object with what `fn` gives for it, e.g its promoted copy after a minor collection.
+        template <typename Fn>
+        void forward_children(Fn&& fn) {
+            for (auto& item : m_items) {
+                if (HeapValuePtr child_p = item.to_object_ptr(); child_p != nullptr) {
+                    item = FastValue {fn(child_p)};
+                }
+            }
+        }
+
+        /// NOTE: Gives the bytes of the item buffer, including its spare capacity.
+        [[nodiscard]] auto get_memory_score() const& noexcept -> std::size_t;
+
+        [[nodiscard]] auto pop_value(SequenceOpPolicy mode) -> FastValue;
+        [[nodiscard]] auto set_value(FastValue arg, std::size_t pos) -> bool;
+
+        void freeze() noexcept;
+
+        [[nodiscard]] auto as_fast_value() noexcept -> FastValue;
+        [[nodiscard]] auto to_string() const& noexcept -> std::string;
     };
 }
 
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <utility>
+
+#include "runtime/task_scheduler.hpp"
+
+namespace Minuet::Runtime::VM {
+    TaskScheduler::TaskScheduler()
+    : m_ready {}, m_spares {} {}
+
+    auto TaskScheduler::has_ready() const noexcept -> bool {
+        return !m_ready.empty();
+    }
+
+    auto TaskScheduler::make_task() -> Task {
+        Task task;
+
+        if (!m_spares.empty()) {
+            task = std::move(m_spares.back());
+            m_spares.pop_back();
+        }
+
+        /// NOTE: A spare may hold the storage of any previously running task, including the home task's.
+        task.memory.resize(cm_task_reg_count);
+        task.call_frames.resize(cm_task_call_frame_count);
+        task.call_frame_top = 0;
+        task.rbp = 0;
+        task.rft = 0;
+        task.reg_high_water = 0;
+        task.rfi = 0;
+        task.rip = 0;
+        task.rrd = 0;
+        task.is_home = false;
+
+        return task;
+    }
+
+    void TaskScheduler::push_ready(Task&& task) {
+        m_ready.emplace_back(std::move(task));
+    }
+
+    auto TaskScheduler::pop_ready() -> Task {
+        Task task = std::move(m_ready.front());
+        m_ready.pop_front();
+
+        return task;
+    }
+
+    void TaskScheduler::recycle(Task&& task) {
+        /// NOTE: Stale object references must not outlive the task, or else a later GC would treat them as roots.
+        std::ranges::fill(task.memory, Runtime::FastValue {});
+
+        m_spares.emplace_back(std::move(task));
+    }
+
+    auto TaskScheduler::take_home() -> std::optional<Task> {
+        auto home_it = std::ranges::find_if(m_ready, [](const Task& task) noexcept { return task.is_home; });
+
+        if (home_it == m_ready.end()) {
+            return {};
+        }
+
+        Task home = std::move(*home_it);
+        m_ready.erase(home_it);
+
+        return home;
+    }
+
+    void TaskScheduler::reset() {
+        while (!m_ready.empty()) {
+            recycle(pop_ready());
+        }
+    }
+
+    auto TaskScheduler::ready_tasks() noexcept -> std::deque<Task>& {
+        return m_ready;
+    }
+}
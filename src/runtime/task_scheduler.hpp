@@ -0,0 +1,73 @@
+#ifndef MINUET_RUNTIME_TASK_SCHEDULER_HPP
+#define MINUET_RUNTIME_TASK_SCHEDULER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "runtime/fast_value.hpp"
+
+namespace Minuet::Runtime::VM {
+    namespace Utils {
+        struct CallFrame {
+            int16_t old_func_idx;
+            int16_t old_func_ip;
+            int old_base_ptr;
+            int old_mem_top; // old register frame top
+            uint8_t old_exec_status;
+        };
+    }
+
+    /// NOTE: A green thread which is not running. Its register window & call frames are owned storage that the engine swaps with its own on a task switch, so frames are never copied.
+    struct Task {
+        std::vector<Runtime::FastValue> memory;
+        std::vector<Utils::CallFrame> call_frames;
+        int call_frame_top; // index of the task's current call frame
+        int rbp;
+        int rft;
+        int reg_high_water;
+        int16_t rfi;
+        int16_t rip;
+        int rrd;
+        bool is_home; // whether this is the task which entered the engine, e.g `main`
+    };
+
+    /**
+     * @brief Round-robin queue of ready green threads for one engine. Every non-running task is ready since tasks only block by yielding. Storage of finished tasks is kept for reuse by later spawns.
+     */
+    class TaskScheduler {
+    private:
+        /// NOTE: starting sizes of a spawned task's register window & call frame stack, which grow like the engine's own
+        static constexpr auto cm_task_reg_count = 256UL;
+        static constexpr auto cm_task_call_frame_count = 64UL;
+
+        std::deque<Task> m_ready;
+        std::vector<Task> m_spares;
+
+    public:
+        TaskScheduler();
+
+        [[nodiscard]] auto has_ready() const noexcept -> bool;
+
+        /// NOTE: Gives a blank task with cleared storage, which the engine fills in for the spawned function.
+        [[nodiscard]] auto make_task() -> Task;
+
+        void push_ready(Task&& task);
+
+        [[nodiscard]] auto pop_ready() -> Task;
+
+        /// NOTE: Keeps a finished task's storage for the next spawn.
+        void recycle(Task&& task);
+
+        /// NOTE: Removes the home task from the ready queue if it is waiting there.
+        [[nodiscard]] auto take_home() -> std::optional<Task>;
+
+        /// NOTE: Drops every ready task, e.g once the home task returns.
+        void reset();
+
+        [[nodiscard]] auto ready_tasks() noexcept -> std::deque<Task>&;
+    };
+}
+
+#endif
@@ -0,0 +1,692 @@
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "runtime/trace_tier.hpp"
+
+namespace Minuet::Runtime::Trace {
+    using Code::Opcode;
+    using Code::ArgMode;
+
+    namespace Utils {
+        /// NOTE: Order matches the `_rr, _ri` pairs of each comparison in `TraceOpcode`.
+        enum class CompareKind : uint8_t {
+            equ,
+            neq,
+            lt,
+            gt,
+            lte,
+            gte,
+        };
+
+        /// NOTE: Order matches the `_rr, _ri` pairs of each arithmetic operation in `TraceOpcode`.
+        enum class ArithKind : uint8_t {
+            add,
+            sub,
+            mul,
+            div,
+            mod,
+        };
+
+        /// NOTE: What the trace knows about a register's tag at some point of one iteration.
+        enum class RegState : uint8_t {
+            unseen, // not written yet in the trace, so an entry guard can check it
+            int32,
+            other,
+        };
+
+        /// NOTE: An int32 operand, being either a register or a constant folded into an immediate.
+        struct Operand {
+            int32_t value;
+            bool is_reg;
+        };
+    }
+
+    [[nodiscard]] static auto arg_mode_at(uint16_t metadata, int arg_pos) noexcept -> ArgMode {
+        return static_cast<ArgMode>((metadata >> (2 + 4 * arg_pos)) & 0b1111);
+    }
+
+    [[nodiscard]] static auto operand_at(const FastValue* frame, const FastValue* consts, ArgMode mode, int16_t id) noexcept -> const FastValue& {
+        return (mode == ArgMode::constant) ? consts[id] : frame[id];
+    }
+
+    [[nodiscard]] static auto is_branch(Opcode op) noexcept -> bool {
+        return op >= Opcode::jump && op <= Opcode::jnge;
+    }
+
+    [[nodiscard]] static auto branch_target(const Code::Instruction& inst) noexcept -> int {
+        switch (inst.op) {
+            case Opcode::jump: return inst.args[0];
+            case Opcode::jump_if:
+            case Opcode::jump_else: return inst.args[1];
+            default: return inst.args[2];
+        }
+    }
+
+    /// NOTE: Gives the int32 comparison under which a fused branch jumps. The negated forms flip exactly since int32 values are totally ordered.
+    [[nodiscard]] static auto fused_jump_kind(Opcode op) noexcept -> Utils::CompareKind {
+        switch (op) {
+            case Opcode::jeq: return Utils::CompareKind::equ;
+            case Opcode::jne: return Utils::CompareKind::neq;
+            case Opcode::jlt: return Utils::CompareKind::lt;
+            case Opcode::jgt: return Utils::CompareKind::gt;
+            case Opcode::jle: return Utils::CompareKind::lte;
+            case Opcode::jge: return Utils::CompareKind::gte;
+            case Opcode::jnlt: return Utils::CompareKind::gte;
+            case Opcode::jngt: return Utils::CompareKind::lte;
+            case Opcode::jnle: return Utils::CompareKind::gt;
+            case Opcode::jnge:
+            default: return Utils::CompareKind::lt;
+        }
+    }
+
+    [[nodiscard]] static auto negate_kind(Utils::CompareKind kind) noexcept -> Utils::CompareKind {
+        switch (kind) {
+            case Utils::CompareKind::equ: return Utils::CompareKind::neq;
+            case Utils::CompareKind::neq: return Utils::CompareKind::equ;
+            case Utils::CompareKind::lt: return Utils::CompareKind::gte;
+            case Utils::CompareKind::gt: return Utils::CompareKind::lte;
+            case Utils::CompareKind::lte: return Utils::CompareKind::gt;
+            case Utils::CompareKind::gte:
+            default: return Utils::CompareKind::lt;
+        }
+    }
+
+    /// NOTE: Gives the comparison which holds for swapped operands, e.g `a < b` as `b > a`.
+    [[nodiscard]] static auto mirror_kind(Utils::CompareKind kind) noexcept -> Utils::CompareKind {
+        switch (kind) {
+            case Utils::CompareKind::lt: return Utils::CompareKind::gt;
+            case Utils::CompareKind::gt: return Utils::CompareKind::lt;
+            case Utils::CompareKind::lte: return Utils::CompareKind::gte;
+            case Utils::CompareKind::gte: return Utils::CompareKind::lte;
+            default: return kind;
+        }
+    }
+
+    [[nodiscard]] static auto arith_kind_of(Opcode op) noexcept -> Utils::ArithKind {
+        switch (op) {
+            case Opcode::add: return Utils::ArithKind::add;
+            case Opcode::sub: return Utils::ArithKind::sub;
+            case Opcode::mul: return Utils::ArithKind::mul;
+            case Opcode::div: return Utils::ArithKind::div;
+            case Opcode::mod:
+            default: return Utils::ArithKind::mod;
+        }
+    }
+
+    [[nodiscard]] static auto trace_opcode_of(TraceOpcode first, int kind, bool rhs_imm) noexcept -> TraceOpcode {
+        return static_cast<TraceOpcode>(static_cast<int>(first) + 2 * kind + static_cast<int>(rhs_imm));
+    }
+
+    auto branch_taken(const Code::Instruction& inst, const FastValue* frame, const FastValue* consts) noexcept -> bool {
+        const auto& [args, metadata, opcode] = inst;
+
+        if (opcode == Opcode::jump) {
+            return true;
+        } else if (opcode == Opcode::jump_if) {
+            return static_cast<bool>(frame[args[0]]);
+        } else if (opcode == Opcode::jump_else) {
+            return !frame[args[0]];
+        }
+
+        const auto& lhs = operand_at(frame, consts, arg_mode_at(metadata, 0), args[0]);
+        const auto& rhs = operand_at(frame, consts, arg_mode_at(metadata, 1), args[1]);
+
+        switch (opcode) {
+            case Opcode::jeq: return lhs == rhs;
+            case Opcode::jne: return !(lhs == rhs);
+            case Opcode::jlt: return lhs < rhs;
+            case Opcode::jgt: return lhs > rhs;
+            case Opcode::jle: return lhs <= rhs;
+            case Opcode::jge: return lhs >= rhs;
+            case Opcode::jnlt: return !(lhs < rhs);
+            case Opcode::jngt: return !(lhs > rhs);
+            case Opcode::jnle: return !(lhs <= rhs);
+            case Opcode::jnge: return !(lhs >= rhs);
+            default: return false;
+        }
+    }
+
+    /**
+     * @brief Builds a trace's operations while tracking which registers are known to be int32. Reads of registers the trace has not written yet become entry guards, and other unproven reads get a guard in place.
+     */
+    class TraceBuilder {
+    private:
+        std::vector<TraceOp> m_guards;
+        std::vector<TraceOp> m_body;
+        std::vector<Utils::RegState> m_regs;
+        int m_header_ip;
+
+        [[nodiscard]] auto state_of(int16_t reg) -> Utils::RegState& {
+            if (static_cast<std::size_t>(reg) >= m_regs.size()) {
+                m_regs.resize(reg + 1, Utils::RegState::unseen);
+            }
+
+            return m_regs[reg];
+        }
+
+    public:
+        explicit TraceBuilder(int header_ip)
+        : m_guards {}, m_body {}, m_regs {}, m_header_ip {header_ip} {}
+
+        void require_int32(int16_t reg, int ip) {
+            auto& state = state_of(reg);
+
+            if (state == Utils::RegState::int32) {
+                return;
+            }
+
+            const auto guard_ip = (state == Utils::RegState::unseen) ? m_header_ip : ip;
+            auto& guards = (state == Utils::RegState::unseen) ? m_guards : m_body;
+
+            guards.emplace_back(TraceOp {
+                .imm = 0,
+                .dest = 0,
+                .lhs = reg,
+                .rhs = 0,
+                .ip = static_cast<int16_t>(guard_ip),
+                .exit_ip = static_cast<int16_t>(guard_ip),
+                .op = TraceOpcode::guard_int32,
+            });
+            state = Utils::RegState::int32;
+        }
+
+        void require_int32(Utils::Operand operand, int ip) {
+            if (operand.is_reg) {
+                require_int32(static_cast<int16_t>(operand.value), ip);
+            }
+        }
+
+        void set_state(int16_t reg, Utils::RegState state) {
+            state_of(reg) = state;
+        }
+
+        [[nodiscard]] auto get_state(int16_t reg) -> Utils::RegState {
+            return state_of(reg);
+        }
+
+        void emit(TraceOp op) {
+            m_body.emplace_back(op);
+        }
+
+        [[nodiscard]] auto finish(int loop_cost) && -> Trace {
+            /// NOTE: Repeats may skip the entry guards only if each iteration leaves every guarded register int32.
+            const auto guards_hold = std::ranges::all_of(m_guards, [this](const TraceOp& guard) {
+                return state_of(guard.lhs) == Utils::RegState::int32;
+            });
+            const auto loop_start = guards_hold ? static_cast<int>(m_guards.size()) : 0;
+
+            std::vector<TraceOp> ops = std::move(m_guards);
+            ops.insert(ops.end(), m_body.begin(), m_body.end());
+
+            return Trace {
+                .ops = std::move(ops),
+                .loop_start = loop_start,
+                .loop_cost = loop_cost,
+                .header_ip = static_cast<int16_t>(m_header_ip),
+            };
+        }
+    };
+
+    TraceRecorder::TraceRecorder(int header_ip)
+    : m_steps {}, m_header_ip {header_ip} {
+        m_steps.reserve(cm_max_steps);
+    }
+
+    auto TraceRecorder::record(int ip, const Code::Instruction& inst, const FastValue* frame, const FastValue* consts) -> RecordResult {
+        const auto op = Code::generic_opcode(inst.op);
+
+        if (m_steps.size() >= cm_max_steps) {
+            return {.next_ip = ip, .action = RecordAction::abort};
+        }
+
+        switch (op) {
+            case Opcode::call:
+            case Opcode::tail_call:
+            case Opcode::spawn:
+            case Opcode::yield:
+            case Opcode::ret:
+            case Opcode::halt:
+                return {.next_ip = ip, .action = RecordAction::abort};
+            case Opcode::nop:
+                return {.next_ip = ip + 1, .action = RecordAction::jump};
+            default:
+                break;
+        }
+
+        RecordedStep step {
+            .inst = inst,
+            .ip = static_cast<int16_t>(ip),
+            .next_ip = static_cast<int16_t>(ip + 1),
+            .tags = {},
+        };
+
+        for (auto arg_pos = 0; arg_pos < 3; ++arg_pos) {
+            const auto mode = arg_mode_at(inst.metadata, arg_pos);
+
+            if (mode == ArgMode::reg) {
+                step.tags[arg_pos] = frame[inst.args[arg_pos]].tag();
+            } else if (mode == ArgMode::constant) {
+                step.tags[arg_pos] = consts[inst.args[arg_pos]].tag();
+            } else {
+                step.tags[arg_pos] = FVTag::dud;
+            }
+        }
+
+        if (!is_branch(op)) {
+            m_steps.emplace_back(step);
+
+            return {.next_ip = ip + 1, .action = RecordAction::step};
+        }
+
+        const auto next_ip = branch_taken(inst, frame, consts) ? branch_target(inst) : ip + 1;
+        step.next_ip = static_cast<int16_t>(next_ip);
+        m_steps.emplace_back(step);
+
+        /// NOTE: Only the header's own back-edge may close the trace, so an inner loop aborts the recording of an outer one.
+        if (next_ip <= ip) {
+            return {
+                .next_ip = ip,
+                .action = (next_ip == m_header_ip) ? RecordAction::close : RecordAction::abort,
+            };
+        }
+
+        return {.next_ip = next_ip, .action = RecordAction::jump};
+    }
+
+    auto TraceRecorder::compile(const FastValue* consts) const -> Trace {
+        TraceBuilder builder {m_header_ip};
+
+        auto int32_operand = [consts](const RecordedStep& step, int arg_pos) -> std::optional<Utils::Operand> {
+            const auto mode = arg_mode_at(step.inst.metadata, arg_pos);
+            const auto id = step.inst.args[arg_pos];
+
+            if (mode == ArgMode::constant && consts[id].tag() == FVTag::int32) {
+                return Utils::Operand {.value = consts[id].to_int32_unchecked(), .is_reg = false};
+            } else if (mode == ArgMode::reg && step.tags[arg_pos] == FVTag::int32) {
+                return Utils::Operand {.value = id, .is_reg = true};
+            }
+
+            return {};
+        };
+
+        auto make_op = [](TraceOpcode op, const RecordedStep& step) noexcept -> TraceOp {
+            return TraceOp {
+                .imm = 0,
+                .dest = 0,
+                .lhs = 0,
+                .rhs = 0,
+                .ip = step.ip,
+                .exit_ip = step.ip,
+                .op = op,
+            };
+        };
+
+        /// NOTE: Sets an operation's right operand, where a register fills `rhs` and an immediate fills `imm`.
+        auto set_rhs = [](TraceOp& op, Utils::Operand rhs) noexcept {
+            if (rhs.is_reg) {
+                op.rhs = static_cast<int16_t>(rhs.value);
+            } else {
+                op.imm = rhs.value;
+            }
+        };
+
+        /// NOTE: The generic handler may write any register arg, so those lose what the trace knew about them.
+        auto emit_step = [&](const RecordedStep& step) {
+            const auto& [args, metadata, opcode] = step.inst;
+
+            builder.emit(make_op(TraceOpcode::step, step));
+
+            if (Code::generic_opcode(opcode) == Opcode::native_call) {
+                for (auto arg_reg = args[2]; arg_reg < args[2] + std::max<int16_t>(args[1], 1); ++arg_reg) {
+                    builder.set_state(arg_reg, Utils::RegState::other);
+                }
+
+                return;
+            }
+
+            for (auto arg_pos = 0; arg_pos < 3; ++arg_pos) {
+                if (arg_mode_at(metadata, arg_pos) == ArgMode::reg) {
+                    builder.set_state(args[arg_pos], Utils::RegState::other);
+                }
+            }
+        };
+
+        for (const auto& step : m_steps) {
+            const auto& [args, metadata, opcode] = step.inst;
+            const auto op = Code::generic_opcode(opcode);
+
+            switch (op) {
+                case Opcode::load_const: {
+                    auto load_op = make_op(TraceOpcode::load_const, step);
+                    load_op.dest = args[0];
+                    load_op.imm = args[1];
+                    builder.emit(load_op);
+                    builder.set_state(args[0], (consts[args[1]].tag() == FVTag::int32) ? Utils::RegState::int32 : Utils::RegState::other);
+                    break;
+                }
+                case Opcode::mov: {
+                    const auto src_mode = arg_mode_at(metadata, 1);
+
+                    if (step.tags[0] == FVTag::val_ref || (src_mode != ArgMode::reg && src_mode != ArgMode::constant)) {
+                        emit_step(step);
+                        break;
+                    }
+
+                    /// NOTE: Proving an int32 source lets later operations on the copy skip their guards.
+                    if (src_mode == ArgMode::reg && step.tags[1] == FVTag::int32) {
+                        builder.require_int32(args[1], step.ip);
+                    }
+
+                    auto mov_op = make_op((src_mode == ArgMode::reg) ? TraceOpcode::mov_reg : TraceOpcode::mov_const, step);
+                    mov_op.dest = args[0];
+                    mov_op.lhs = args[1];
+                    mov_op.imm = args[1];
+                    const auto src_is_int32 = (src_mode == ArgMode::reg)
+                        ? builder.get_state(args[1]) == Utils::RegState::int32
+                        : consts[args[1]].tag() == FVTag::int32;
+
+                    builder.emit(mov_op);
+                    builder.set_state(args[0], src_is_int32 ? Utils::RegState::int32 : Utils::RegState::other);
+                    break;
+                }
+                case Opcode::inc:
+                case Opcode::dec: {
+                    if (step.tags[0] != FVTag::int32) {
+                        emit_step(step);
+                        break;
+                    }
+
+                    builder.require_int32(args[0], step.ip);
+
+                    auto step_op = make_op((op == Opcode::inc) ? TraceOpcode::inc_i32 : TraceOpcode::dec_i32, step);
+                    step_op.dest = args[0];
+                    builder.emit(step_op);
+                    break;
+                }
+                case Opcode::add_assign:
+                case Opcode::sub_assign: {
+                    const auto rhs_opt = int32_operand(step, 1);
+
+                    if (step.tags[0] != FVTag::int32 || !rhs_opt) {
+                        emit_step(step);
+                        break;
+                    }
+
+                    builder.require_int32(args[0], step.ip);
+                    builder.require_int32(*rhs_opt, step.ip);
+
+                    const auto kind = (op == Opcode::add_assign) ? Utils::ArithKind::add : Utils::ArithKind::sub;
+                    auto arith_op = make_op(trace_opcode_of(TraceOpcode::add_rr_i32, static_cast<int>(kind), !rhs_opt->is_reg), step);
+                    arith_op.dest = args[0];
+                    arith_op.lhs = args[0];
+                    set_rhs(arith_op, *rhs_opt);
+                    builder.emit(arith_op);
+                    break;
+                }
+                case Opcode::add:
+                case Opcode::sub:
+                case Opcode::mul:
+                case Opcode::div:
+                case Opcode::mod: {
+                    auto lhs_opt = int32_operand(step, 1);
+                    auto rhs_opt = int32_operand(step, 2);
+                    const auto kind = arith_kind_of(op);
+                    const auto commutes = kind == Utils::ArithKind::add || kind == Utils::ArithKind::mul;
+
+                    if (lhs_opt && rhs_opt && !lhs_opt->is_reg && rhs_opt->is_reg && commutes) {
+                        std::swap(lhs_opt, rhs_opt);
+                    }
+
+                    if (!lhs_opt || !rhs_opt || !lhs_opt->is_reg) {
+                        emit_step(step);
+                        break;
+                    }
+
+                    builder.require_int32(*lhs_opt, step.ip);
+                    builder.require_int32(*rhs_opt, step.ip);
+
+                    auto arith_op = make_op(trace_opcode_of(TraceOpcode::add_rr_i32, static_cast<int>(kind), !rhs_opt->is_reg), step);
+                    arith_op.dest = args[0];
+                    arith_op.lhs = static_cast<int16_t>(lhs_opt->value);
+                    set_rhs(arith_op, *rhs_opt);
+                    builder.emit(arith_op);
+                    builder.set_state(args[0], Utils::RegState::int32);
+                    break;
+                }
+                case Opcode::equ:
+                case Opcode::neq:
+                case Opcode::lt:
+                case Opcode::gt:
+                case Opcode::lte:
+                case Opcode::gte: {
+                    auto lhs_opt = int32_operand(step, 1);
+                    auto rhs_opt = int32_operand(step, 2);
+                    auto kind = static_cast<Utils::CompareKind>(static_cast<int>(op) - static_cast<int>(Opcode::equ));
+
+                    if (lhs_opt && rhs_opt && !lhs_opt->is_reg && rhs_opt->is_reg) {
+                        std::swap(lhs_opt, rhs_opt);
+                        kind = mirror_kind(kind);
+                    }
+
+                    if (!lhs_opt || !rhs_opt || !lhs_opt->is_reg) {
+                        emit_step(step);
+                        break;
+                    }
+
+                    builder.require_int32(*lhs_opt, step.ip);
+                    builder.require_int32(*rhs_opt, step.ip);
+
+                    auto compare_op = make_op(trace_opcode_of(TraceOpcode::equ_rr_i32, static_cast<int>(kind), !rhs_opt->is_reg), step);
+                    compare_op.dest = args[0];
+                    compare_op.lhs = static_cast<int16_t>(lhs_opt->value);
+                    set_rhs(compare_op, *rhs_opt);
+                    builder.emit(compare_op);
+                    builder.set_state(args[0], Utils::RegState::other);
+                    break;
+                }
+                case Opcode::jump:
+                    break;
+                case Opcode::jump_if:
+                case Opcode::jump_else: {
+                    const auto target = branch_target(step.inst);
+
+                    if (target == step.ip + 1) {
+                        break;
+                    }
+
+                    const auto taken = step.next_ip == target;
+                    const auto exits_on_truthy = (op == Opcode::jump_if) != taken;
+                    auto exit_op = make_op(exits_on_truthy ? TraceOpcode::exit_truthy : TraceOpcode::exit_falsy, step);
+                    exit_op.lhs = args[0];
+                    exit_op.exit_ip = static_cast<int16_t>(taken ? step.ip + 1 : target);
+                    builder.emit(exit_op);
+                    break;
+                }
+                default: {
+                    if (!is_branch(op)) {
+                        emit_step(step);
+                        break;
+                    }
+
+                    const auto target = branch_target(step.inst);
+
+                    if (target == step.ip + 1) {
+                        break;
+                    }
+
+                    const auto taken = step.next_ip == target;
+                    const auto exit_ip = static_cast<int16_t>(taken ? step.ip + 1 : target);
+                    auto lhs_opt = int32_operand(step, 0);
+                    auto rhs_opt = int32_operand(step, 1);
+                    /// NOTE: The trace leaves when the branch would go the other way, i.e when the negated recorded outcome holds.
+                    auto kind = taken ? negate_kind(fused_jump_kind(op)) : fused_jump_kind(op);
+
+                    if (lhs_opt && rhs_opt && !lhs_opt->is_reg) {
+                        if (!rhs_opt->is_reg) {
+                            break; // NOTE: two constants always branch the recorded way
+                        }
+
+                        std::swap(lhs_opt, rhs_opt);
+                        kind = mirror_kind(kind);
+                    }
+
+                    if (!lhs_opt || !rhs_opt) {
+                        auto exit_op = make_op(TraceOpcode::exit_branch, step);
+                        exit_op.imm = static_cast<int32_t>(taken);
+                        exit_op.exit_ip = exit_ip;
+                        builder.emit(exit_op);
+                        break;
+                    }
+
+                    builder.require_int32(*lhs_opt, step.ip);
+                    builder.require_int32(*rhs_opt, step.ip);
+
+                    auto exit_op = make_op(trace_opcode_of(TraceOpcode::exit_equ_rr_i32, static_cast<int>(kind), !rhs_opt->is_reg), step);
+                    exit_op.lhs = static_cast<int16_t>(lhs_opt->value);
+                    exit_op.exit_ip = exit_ip;
+                    set_rhs(exit_op, *rhs_opt);
+                    builder.emit(exit_op);
+                    break;
+                }
+            }
+        }
+
+        const auto close_ip = m_steps.back().ip;
+        const auto loop_cost = close_ip - m_header_ip + 1;
+        auto loop_op = make_op(TraceOpcode::loop, m_steps.back());
+        loop_op.imm = loop_cost;
+        loop_op.exit_ip = static_cast<int16_t>(m_header_ip);
+        builder.emit(loop_op);
+
+        return std::move(builder).finish(loop_cost);
+    }
+
+    /// NOTE: Operand accessors of the trace loop, where the right operand is a register or an immediate depending on the `_rr, _ri` form.
+    #define MINUET_TRACE_LHS() frame[top.lhs].to_int32_unchecked()
+    #define MINUET_TRACE_RHS_rr() frame[top.rhs].to_int32_unchecked()
+    #define MINUET_TRACE_RHS_ri() top.imm
+
+    #define MINUET_TRACE_ARITH(name, form, op_token) \
+        case TraceOpcode::name##_##form##_i32: \
+            frame[top.dest] = FastValue {MINUET_TRACE_LHS() op_token MINUET_TRACE_RHS_##form()}; \
+            break;
+
+    #define MINUET_TRACE_DIVIDE(name, form, op_token) \
+        case TraceOpcode::name##_##form##_i32: { \
+            const int rhs_i32 = MINUET_TRACE_RHS_##form(); \
+            if (rhs_i32 == 0) { \
+                return top.exit_ip; \
+            } \
+            frame[top.dest] = FastValue {MINUET_TRACE_LHS() op_token rhs_i32}; \
+            break; \
+        }
+
+    #define MINUET_TRACE_COMPARE(name, form, op_token) \
+        case TraceOpcode::name##_##form##_i32: \
+            frame[top.dest] = FastValue {MINUET_TRACE_LHS() op_token MINUET_TRACE_RHS_##form()}; \
+            break; \
+        case TraceOpcode::exit_##name##_##form##_i32: \
+            if (MINUET_TRACE_LHS() op_token MINUET_TRACE_RHS_##form()) { \
+                return top.exit_ip; \
+            } \
+            break;
+
+    auto run_trace(const Trace& trace, const Code::Instruction* code, FastValue* frame, const FastValue* consts, int64_t& ticks_left, StepFn step_fn, void* engine) -> int {
+        const TraceOp* ops = trace.ops.data();
+        int pc = 0;
+
+        while (true) {
+            const auto& top = ops[pc];
+
+            switch (top.op) {
+                case TraceOpcode::guard_int32:
+                    if (frame[top.lhs].tag() != FVTag::int32) {
+                        return top.exit_ip;
+                    }
+                    break;
+                case TraceOpcode::load_const:
+                    frame[top.dest] = consts[top.imm];
+                    break;
+                case TraceOpcode::mov_reg:
+                    if (frame[top.dest].tag() == FVTag::val_ref) {
+                        return top.exit_ip;
+                    }
+                    frame[top.dest] = frame[top.lhs];
+                    break;
+                case TraceOpcode::mov_const:
+                    if (frame[top.dest].tag() == FVTag::val_ref) {
+                        return top.exit_ip;
+                    }
+                    frame[top.dest] = consts[top.imm];
+                    break;
+                case TraceOpcode::inc_i32:
+                    frame[top.dest] = FastValue {frame[top.dest].to_int32_unchecked() + 1};
+                    break;
+                case TraceOpcode::dec_i32:
+                    frame[top.dest] = FastValue {frame[top.dest].to_int32_unchecked() - 1};
+                    break;
+                MINUET_TRACE_ARITH(add, rr, +)
+                MINUET_TRACE_ARITH(add, ri, +)
+                MINUET_TRACE_ARITH(sub, rr, -)
+                MINUET_TRACE_ARITH(sub, ri, -)
+                MINUET_TRACE_ARITH(mul, rr, *)
+                MINUET_TRACE_ARITH(mul, ri, *)
+                MINUET_TRACE_DIVIDE(div, rr, /)
+                MINUET_TRACE_DIVIDE(div, ri, /)
+                MINUET_TRACE_DIVIDE(mod, rr, %)
+                MINUET_TRACE_DIVIDE(mod, ri, %)
+                MINUET_TRACE_COMPARE(equ, rr, ==)
+                MINUET_TRACE_COMPARE(equ, ri, ==)
+                MINUET_TRACE_COMPARE(neq, rr, !=)
+                MINUET_TRACE_COMPARE(neq, ri, !=)
+                MINUET_TRACE_COMPARE(lt, rr, <)
+                MINUET_TRACE_COMPARE(lt, ri, <)
+                MINUET_TRACE_COMPARE(gt, rr, >)
+                MINUET_TRACE_COMPARE(gt, ri, >)
+                MINUET_TRACE_COMPARE(lte, rr, <=)
+                MINUET_TRACE_COMPARE(lte, ri, <=)
+                MINUET_TRACE_COMPARE(gte, rr, >=)
+                MINUET_TRACE_COMPARE(gte, ri, >=)
+                case TraceOpcode::exit_truthy:
+                    if (frame[top.lhs]) {
+                        return top.exit_ip;
+                    }
+                    break;
+                case TraceOpcode::exit_falsy:
+                    if (!frame[top.lhs]) {
+                        return top.exit_ip;
+                    }
+                    break;
+                case TraceOpcode::exit_branch:
+                    if (branch_taken(code[top.ip], frame, consts) != (top.imm != 0)) {
+                        return top.exit_ip;
+                    }
+                    break;
+                case TraceOpcode::step:
+                    if (!step_fn(engine, frame, code + top.ip)) {
+                        return top.ip;
+                    }
+                    break;
+                case TraceOpcode::loop:
+                default:
+                    /// NOTE: A spent tick window leaves at the header, where the interpreter handles the preemption.
+                    if ((ticks_left -= top.imm) <= 0) {
+                        return top.exit_ip;
+                    }
+
+                    pc = trace.loop_start;
+                    continue;
+            }
+
+            ++pc;
+        }
+    }
+
+    #undef MINUET_TRACE_COMPARE
+    #undef MINUET_TRACE_DIVIDE
+    #undef MINUET_TRACE_ARITH
+    #undef MINUET_TRACE_RHS_ri
+    #undef MINUET_TRACE_RHS_rr
+    #undef MINUET_TRACE_LHS
+}
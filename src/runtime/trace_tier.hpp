@@ -0,0 +1,137 @@
+#ifndef MINUET_RUNTIME_TRACE_TIER_HPP
+#define MINUET_RUNTIME_TRACE_TIER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "runtime/fast_value.hpp"
+#include "runtime/bytecode.hpp"
+
+namespace Minuet::Runtime::Trace {
+    /// NOTE: Specialized operations of a trace. Most `_i32` operations assume int32 operands, which guards earlier in the trace ensure. `_ri` forms take an int32 immediate as their right operand.
+    enum class TraceOpcode : uint8_t {
+        guard_int32,    // exits unless `frame[lhs]` is an int32
+        load_const,     // `frame[dest] = consts[imm]`
+        mov_reg,        // `frame[dest] = frame[lhs]`, exiting if the destination is a reference
+        mov_const,      // `frame[dest] = consts[imm]`, exiting if the destination is a reference
+        inc_i32,
+        dec_i32,
+        add_rr_i32,
+        add_ri_i32,
+        sub_rr_i32,
+        sub_ri_i32,
+        mul_rr_i32,
+        mul_ri_i32,
+        div_rr_i32,     // exits on a zero divisor, so that the generic handler reports it
+        div_ri_i32,
+        mod_rr_i32,
+        mod_ri_i32,
+        equ_rr_i32,
+        equ_ri_i32,
+        neq_rr_i32,
+        neq_ri_i32,
+        lt_rr_i32,
+        lt_ri_i32,
+        gt_rr_i32,
+        gt_ri_i32,
+        lte_rr_i32,
+        lte_ri_i32,
+        gte_rr_i32,
+        gte_ri_i32,
+        // NOTE: side exits for branches, which leave the trace once the branch would go off the recorded path
+        exit_equ_rr_i32,
+        exit_equ_ri_i32,
+        exit_neq_rr_i32,
+        exit_neq_ri_i32,
+        exit_lt_rr_i32,
+        exit_lt_ri_i32,
+        exit_gt_rr_i32,
+        exit_gt_ri_i32,
+        exit_lte_rr_i32,
+        exit_lte_ri_i32,
+        exit_gte_rr_i32,
+        exit_gte_ri_i32,
+        exit_truthy,    // exits if `frame[lhs]` is truthy
+        exit_falsy,     // exits if `frame[lhs]` is falsy
+        exit_branch,    // re-evaluates the branch instruction at `ip`, exiting unless it goes the recorded way (`imm` is `1` for taken)
+        step,           // runs the instruction at `ip` through the engine's generic handlers
+        loop,           // charges one iteration's ticks & repeats the trace
+    };
+
+    struct TraceOp {
+        int32_t imm;
+        int16_t dest;
+        int16_t lhs;
+        int16_t rhs;
+        int16_t ip;      // instruction this operation came from
+        int16_t exit_ip; // where the interpreter resumes on a side exit
+        TraceOpcode op;
+    };
+
+    /// NOTE: A straight-line superblock for one loop header. Its leading `int32` guards cover registers read before the trace writes them, and `loop_start` skips them on repeats once the trace keeps those registers int32 itself.
+    struct Trace {
+        std::vector<TraceOp> ops;
+        int loop_start;
+        int loop_cost; // ticks of one iteration, the same as the interpreter's back-edge charge
+        int16_t header_ip;
+    };
+
+    /// NOTE: Back-edge profile of one instruction slot as a possible loop header.
+    struct HeaderSlot {
+        int hits;
+        int16_t trace_id; // index into the engine's traces, or `-1` if none
+        uint8_t failures; // aborted recordings, after which the header stays interpreted
+    };
+
+    enum class RecordAction : uint8_t {
+        step,  // the engine runs the instruction
+        jump,  // the recorder resolved a jump or `nop` itself
+        close, // the instruction jumps back to the header, so the trace is done
+        abort, // the instruction cannot be traced, e.g a call
+    };
+
+    struct RecordResult {
+        int next_ip;
+        RecordAction action;
+    };
+
+    /// NOTE: Runs one instruction through the engine's handlers, returning `false` if it set an error status.
+    using StepFn = bool (*)(void* engine, FastValue* frame, const Code::Instruction* inst);
+
+    /**
+     * @brief Records the instructions of one loop iteration along with their operand tags, starting at a hot loop header. The engine runs each instruction as it is recorded, so recording makes progress like interpreting.
+     */
+    class TraceRecorder {
+    private:
+        struct RecordedStep {
+            Code::Instruction inst;
+            int16_t ip;
+            int16_t next_ip;
+            FVTag tags[3];
+        };
+
+        static constexpr auto cm_max_steps = 256UL;
+
+        std::vector<RecordedStep> m_steps;
+        int m_header_ip;
+
+    public:
+        explicit TraceRecorder(int header_ip);
+
+        /// NOTE: Records the instruction at `ip` before it runs, telling the engine what to do with it.
+        [[nodiscard]] auto record(int ip, const Code::Instruction& inst, const FastValue* frame, const FastValue* consts) -> RecordResult;
+
+        /// NOTE: Specializes the recorded iteration after `record()` gave `RecordAction::close`.
+        [[nodiscard]] auto compile(const FastValue* consts) const -> Trace;
+    };
+
+    [[nodiscard]] auto branch_taken(const Code::Instruction& inst, const FastValue* frame, const FastValue* consts) noexcept -> bool;
+
+    /**
+     * @brief Runs a trace from its header until a side exit or the end of the tick window.
+     * @return The IP where the interpreter continues. A failed step leaves its status in the engine & returns that step's IP.
+     */
+    [[nodiscard]] auto run_trace(const Trace& trace, const Code::Instruction* code, FastValue* frame, const FastValue* consts, int64_t& ticks_left, StepFn step_fn, void* engine) -> int;
+}
+
+#endif
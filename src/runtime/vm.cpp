@@ -1,48 +1,325 @@
 #include <utility>
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iterator>
+#include <limits>
 // #include <print>
-#include <queue>
-#include <set>
 
 #include "runtime/fast_value.hpp"
 #include "runtime/bytecode.hpp"
 #include "runtime/sequence_value.hpp"
+#include "runtime/heap_objects.hpp"
 #include "runtime/vm.hpp"
 
+#ifndef MINUET_VM_THREADED_DISPATCH
+    #define MINUET_VM_THREADED_DISPATCH 0
+#endif
+
+#if MINUET_VM_THREADED_DISPATCH
+    #define MINUET_VM_OP(name) op_##name
+    #define MINUET_VM_NEXT() goto *dispatch_table[static_cast<std::size_t>(code[rip].op)]
+#else
+    #define MINUET_VM_OP(name) case Code::Opcode::name
+    #define MINUET_VM_NEXT() continue
+#endif
+
+#define MINUET_VM_SPILL_REGS() \
+    do { \
+        m_rip = static_cast<int16_t>(rip); \
+        m_rbp = rbp; \
+    } while (false)
+
+#define MINUET_VM_RELOAD_REGS() \
+    do { \
+        code = m_chunk_view[m_rfi].data(); \
+        sites = (m_feedback_view != nullptr) ? m_feedback_view[m_rfi].data() : nullptr; \
+        headers = (m_trace_threshold > 0) ? m_header_slots[m_rfi].data() : nullptr; \
+        rip = m_rip; \
+        rbp = m_rbp; \
+        frame = m_memory.data() + rbp; \
+    } while (false)
+
+#define MINUET_VM_CHECK_STATUS() \
+    do { \
+        if (m_res != ok_res_value) { \
+            MINUET_VM_SPILL_REGS(); \
+            goto vm_exit; \
+        } \
+    } while (false)
+
+/// NOTE: Charges `cost` against the current tick window, which ends at the next task switch or the slice budget's end. Only back-edges & calls charge the window so that straight-line code pays nothing.
+#define MINUET_VM_CHARGE_SLICE(cost) \
+    do { \
+        if ((ticks_left -= (cost)) <= 0) [[unlikely]] { \
+            MINUET_VM_SPILL_REGS(); \
+            goto vm_preempt; \
+        } \
+    } while (false)
+
+/// NOTE: A taken backward jump costs the length of the span it repeats, approximating the instructions run by one loop iteration. Its target is a loop header, which runs its trace if it has one.
+#define MINUET_VM_CHECK_BACK_EDGE(jump_from) \
+    do { \
+        if (rip <= (jump_from)) { \
+            MINUET_VM_CHARGE_SLICE((jump_from) - rip + 1); \
+            MINUET_VM_TRY_TRACE(); \
+        } \
+    } while (false)
+
+/// NOTE: Enters the trace of the loop header at `rip`, or records one once the header's back-edges reach the trace threshold.
+#define MINUET_VM_TRY_TRACE() \
+    do { \
+        if (headers != nullptr) { \
+            if (auto& header = headers[rip]; header.trace_id >= 0) { \
+                goto vm_trace; \
+            } else if (header.hits < m_trace_threshold && ++header.hits == m_trace_threshold) { \
+                goto vm_record; \
+            } \
+        } \
+    } while (false)
+
+/// NOTE: Leaves the interpreter for the current function's compiled code once it has some.
+#define MINUET_VM_TRY_JIT() \
+    do { \
+        if (m_jit_threshold > 0 && (jit_entry = prepare_jit(m_rfi)) != nullptr) { \
+            goto vm_jit; \
+        } \
+    } while (false)
+
+/// NOTE: Operand accessors for the quickened opcodes, which already know each operand's `ArgMode`.
+#define MINUET_VM_R(n) frame[args[n]]
+#define MINUET_VM_C(n) consts[args[n]]
+
+/// NOTE: Feeds the operand tags of an `add, sub, mul, lt` site to its type feedback, possibly rewriting the site to `int32_op`.
+#define MINUET_VM_OBSERVE_SITE(int32_op, lhs, rhs) \
+    do { \
+        if constexpr (Code::Opcode::int32_op != Code::Opcode::last) { \
+            if (sites != nullptr) { \
+                observe_int32_site(code[rip], sites[rip], Code::Opcode::int32_op, (lhs).tag() == FVTag::int32 && (rhs).tag() == FVTag::int32); \
+            } \
+        } \
+    } while (false)
+
+#define MINUET_VM_QUICK_ARITH(name, int32_op, op_token, lhs_of, rhs_of) \
+    MINUET_VM_OP(name): { \
+        const auto& [args, metadata, opcode] = code[rip]; \
+        MINUET_VM_OBSERVE_SITE(int32_op, lhs_of(1), rhs_of(2)); \
+        FastValue temp = lhs_of(1); \
+        temp op_token rhs_of(2); \
+        frame[args[0]] = temp; \
+        ++rip; \
+        MINUET_VM_NEXT(); \
+    }
+
+#define MINUET_VM_QUICK_DIVIDE(name, op_token, lhs_of, rhs_of) \
+    MINUET_VM_OP(name): { \
+        const auto& [args, metadata, opcode] = code[rip]; \
+        FastValue lhs_temp = lhs_of(1); \
+        if (auto temp = lhs_temp op_token rhs_of(2); !temp.is_none()) { \
+            frame[args[0]] = temp; \
+        } else { \
+            m_res = static_cast<int>(Utils::ExecStatus::math_error); \
+            MINUET_VM_SPILL_REGS(); \
+            goto vm_exit; \
+        } \
+        ++rip; \
+        MINUET_VM_NEXT(); \
+    }
+
+#define MINUET_VM_QUICK_COMPARE(name, int32_op, op_token, lhs_of, rhs_of) \
+    MINUET_VM_OP(name): { \
+        const auto& [args, metadata, opcode] = code[rip]; \
+        MINUET_VM_OBSERVE_SITE(int32_op, lhs_of(1), rhs_of(2)); \
+        frame[args[0]] = (lhs_of(1) op_token rhs_of(2)); \
+        ++rip; \
+        MINUET_VM_NEXT(); \
+    }
+
+/// NOTE: An int32-specialized site runs only when both operands are still int32. Otherwise, the site is deoptimized back to its generic opcode, which is then dispatched for the same instruction.
+#define MINUET_VM_INT32_OP(name, generic_handler, result_expr) \
+    MINUET_VM_OP(name): { \
+        const auto& [args, metadata, opcode] = code[rip]; \
+        const auto& lhs = operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]); \
+        const auto& rhs = operand_of(frame, consts, arg_mode_of<2>(metadata), args[2]); \
+        if (lhs.tag() != FVTag::int32 || rhs.tag() != FVTag::int32) [[unlikely]] { \
+            if (sites != nullptr) { \
+                deopt_int32_site(code[rip], sites[rip]); \
+                MINUET_VM_NEXT(); \
+            } \
+            generic_handler(frame, metadata, args[0], args[1], args[2]); \
+        } else { \
+            const int lhs_i32 = lhs.to_int32_unchecked(); \
+            const int rhs_i32 = rhs.to_int32_unchecked(); \
+            frame[args[0]] = FastValue {result_expr}; \
+        } \
+        ++rip; \
+        MINUET_VM_NEXT(); \
+    }
+
+/// NOTE: Fused compare-and-branch opcodes take `<lhs> <rhs> <target-ip: imm>`, jumping when `lhs op_token rhs` is `!negated`.
+#define MINUET_VM_FUSED_BRANCH(name, op_token, negated) \
+    MINUET_VM_OP(name): { \
+        const auto& [args, metadata, opcode] = code[rip]; \
+        const auto& lhs = operand_of(frame, consts, arg_mode_of<0>(metadata), args[0]); \
+        const auto& rhs = operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]); \
+        const int jump_from = rip; \
+        rip = ((lhs op_token rhs) != negated) ? args[2] : rip + 1; \
+        MINUET_VM_CHECK_BACK_EDGE(jump_from); \
+        MINUET_VM_NEXT(); \
+    }
+
 namespace Minuet::Runtime::VM {
     using Minuet::Runtime::FastValue;
 
     static constexpr auto ok_res_value = static_cast<int>(Utils::ExecStatus::ok);
 
+    /// NOTE: How many all-int32 executions a site needs before it is specialized.
+    static constexpr uint8_t int32_site_warmup = 4;
+
+    /// NOTE: How many recordings of a loop header may abort before it is left to the interpreter.
+    static constexpr uint8_t trace_max_failures = 3;
+
+    template <int ArgPos>
+    [[nodiscard]] static constexpr auto arg_mode_of(uint16_t metadata) noexcept -> Code::ArgMode {
+        static_assert(ArgPos >= 0 && ArgPos < 3);
+
+        return static_cast<Code::ArgMode>((metadata >> (2 + 4 * ArgPos)) & 0b1111);
+    }
+
+    /// NOTE: Binary arithmetic & comparison operands are only ever registers or constants.
+    [[nodiscard]] static auto operand_of(const FastValue* frame, const FastValue* consts, Code::ArgMode mode, int16_t id) noexcept -> const FastValue& {
+        return (mode == Code::ArgMode::constant) ? consts[id] : frame[id];
+    }
+
+    static void observe_int32_site(Code::Instruction& inst, Code::SiteFeedback& site, Code::Opcode int32_op, bool int32_operands) noexcept {
+        if (site.unstable) {
+            return;
+        }
+
+        if (!int32_operands) {
+            site.unstable = true;
+            return;
+        }
+
+        if (++site.int32_hits >= int32_site_warmup) {
+            site.generic_op = inst.op;
+            inst.op = int32_op;
+        }
+    }
+
+    static void deopt_int32_site(Code::Instruction& inst, Code::SiteFeedback& site) noexcept {
+        inst.op = site.generic_op;
+        site.unstable = true;
+    }
+
     Engine::Engine(Utils::EngineConfig config, Code::Program& prgm, std::any native_fn_table_wrap)
-    : m_heap {}, m_memory {}, m_call_frames {}, m_chunk_view {}, m_const_view {}, m_call_frame_ptr {nullptr}, m_native_funcs {}, m_rfi {}, m_rip {}, m_rbp {}, m_rft {}, m_rsp {}, m_consts_n {}, m_rrd {}, m_res {} {
-        const auto [mem_limit, recur_depth_max] = config;
+    : m_heap {static_cast<std::size_t>(std::max(config.gc_growth_percent, 0))}, m_tasks {}, m_memory {}, m_call_frames {}, m_own_chunks {}, m_own_feedback {}, m_jit_chunks {}, m_call_counts {}, m_jit_ctx {}, m_header_slots {}, m_traces {}, m_gc_pauses {}, m_gc_observer {nullptr}, m_gc_observer_context {nullptr}, m_gc_census_top {0UL}, m_chunk_view {}, m_feedback_view {}, m_const_view {}, m_call_frame_ptr {nullptr}, m_native_funcs {}, m_frame_view {}, m_function_ids {}, m_rfi {}, m_rip {}, m_rbp {}, m_rft {}, m_reg_high_water {}, m_native_base {}, m_rsp {}, m_consts_n {}, m_reg_limit {}, m_call_frame_limit {}, m_slice_budget {}, m_task_quantum {}, m_quantum_left {}, m_jit_threshold {}, m_trace_threshold {}, m_gc_max_pause_ns {}, m_gc_threads {}, m_funcs_n {}, m_rrd {}, m_res {}, m_setup_ok {}, m_on_home_task {true}, m_payload_grew {false} {
+        const auto [mem_limit, recur_depth_max, quicken_code, feedback_mode, slice_budget, task_quantum, jit_threshold, trace_threshold, gc_max_pause, gc_growth_percent, gc_threads] = config;
         const auto prgm_entry_fn_id = prgm.entry_id.value_or(-1);
 
-        const auto mem_vec_size = static_cast<std::size_t>(mem_limit);
-        m_memory.reserve(mem_vec_size);
-        m_memory.resize(mem_vec_size);
+        if (quicken_code) {
+            Code::quicken_program(prgm);
+        }
+
+        /// NOTE: Both stacks start small so that short scripts stay light, then grow as calls need them.
+        m_reg_limit = std::max(mem_limit, 1);
+        m_call_frame_limit = std::max(recur_depth_max, 1);
+        m_memory.resize(std::min(m_reg_limit, cm_initial_reg_count));
+        m_call_frames.resize(std::min(m_call_frame_limit, cm_initial_call_frame_count));
 
-        m_call_frames.reserve(recur_depth_max);
-        m_call_frames.resize(recur_depth_max);
+        switch (feedback_mode) {
+            case Utils::FeedbackMode::shared:
+                if (prgm.feedback.size() != prgm.chunks.size()) {
+                    prgm.feedback = Code::make_feedback(prgm.chunks);
+                }
+
+                m_chunk_view = prgm.chunks.data();
+                m_feedback_view = prgm.feedback.data();
+                break;
+            case Utils::FeedbackMode::isolated:
+                m_own_chunks = prgm.chunks;
+                m_own_feedback = Code::make_feedback(m_own_chunks);
+                m_chunk_view = m_own_chunks.data();
+                m_feedback_view = m_own_feedback.data();
+                break;
+            case Utils::FeedbackMode::off:
+            default:
+                m_chunk_view = prgm.chunks.data();
+                m_feedback_view = nullptr;
+                break;
+        }
 
-        m_chunk_view = prgm.chunks.data();
         m_const_view = prgm.constants.data();
+        m_frame_view = prgm.frames.data();
         m_call_frame_ptr = m_call_frames.data();
         m_native_funcs = (native_fn_table_wrap.type() == typeid(Runtime::NativeProcTable*))
             ? std::any_cast<Runtime::NativeProcTable*>(native_fn_table_wrap)
             : nullptr;
 
+        m_function_ids = &prgm.function_ids;
+        m_funcs_n = static_cast<int>(prgm.chunks.size());
+        m_jit_threshold = (JIT::is_supported()) ? jit_threshold : 0;
+
+        if (m_jit_threshold > 0) {
+            m_jit_chunks.resize(m_funcs_n);
+            m_call_counts.resize(m_funcs_n, 0);
+        }
+
+        m_trace_threshold = trace_threshold;
+
+        if (m_trace_threshold > 0) {
+            m_header_slots.reserve(m_funcs_n);
+
+            for (auto func_id = 0; func_id < m_funcs_n; ++func_id) {
+                m_header_slots.emplace_back(m_chunk_view[func_id].size(), Trace::HeaderSlot {
+                    .hits = 0,
+                    .trace_id = -1,
+                    .failures = 0,
+                });
+            }
+        }
+
+        m_gc_max_pause_ns = std::max<int64_t>(gc_max_pause, 0) * 1000;
+        m_gc_threads = static_cast<std::size_t>(std::max(gc_threads, 1));
+
+        m_setup_ok = m_native_funcs != nullptr && prgm.frames.size() == prgm.chunks.size();
+
         m_rfi = prgm_entry_fn_id;
         m_rip = 0;
         m_rbp = 0;
         m_rft = 0;
+        m_reg_high_water = 0;
+        m_native_base = 0;
         m_rsp = -1;
-        m_res = (prgm_entry_fn_id >= 0 && m_native_funcs != nullptr)
+        m_res = (prgm_entry_fn_id >= 0 && m_setup_ok)
             ? static_cast<int>(Utils::ExecStatus::ok)
             : static_cast<int>(Utils::ExecStatus::setup_error);
 
+        if (m_res == ok_res_value && !fit_registers(frame_top_of(m_rfi, 0))) {
+            m_res = static_cast<int>(Utils::ExecStatus::stack_overflow);
+        }
+
         m_consts_n = static_cast<int>(prgm.constants.size());
+        m_slice_budget = slice_budget;
+        m_task_quantum = task_quantum;
+        m_quantum_left = (task_quantum > 0) ? task_quantum : std::numeric_limits<int64_t>::max();
+
+        if (m_res == ok_res_value) {
+            enter_function(m_rfi);
+        }
+    }
+
+    /**
+     * @brief Points the VM registers at the start of a function as the outermost call, e.g `main`. The callee's frame begins at memory cell `0`.
+     */
+    void Engine::enter_function(int16_t func_id) noexcept {
+        count_call(func_id);
+        m_rfi = func_id;
+        m_rip = 0;
+        m_rbp = 0;
+        m_rft = std::max<int>(m_frame_view[func_id].temp_count, 1) - 1;
+        m_reg_high_water = std::max(m_reg_high_water, m_rft);
+        m_call_frame_ptr = m_call_frames.data();
 
         *m_call_frame_ptr = Utils::CallFrame {
             .old_func_idx = 0,
@@ -51,191 +328,997 @@ namespace Minuet::Runtime::VM {
             .old_mem_top = 0,
             .old_exec_status = ok_res_value,
         };
-        ++m_rrd; // NOTE: main is implicitly called if present... call depth is now 1 to count this!
+        m_rrd = 1; // NOTE: the outermost function is implicitly called... call depth is now 1 to count this!
     }
 
-    auto Engine::operator()() -> Utils::ExecStatus {
-        while (m_rrd > 0 && m_res == ok_res_value) {
-            const auto& [args, metadata, opcode] = m_chunk_view[m_rfi][m_rip];
+    /**
+     * @brief Exchanges the running task's registers & storage with a suspended task's. Only the vectors' buffers trade places, so no register frame is copied.
+     */
+    void Engine::swap_task(Task& task) noexcept {
+        const int running_frame_top = static_cast<int>(m_call_frame_ptr - m_call_frames.data());
+
+        std::swap(m_memory, task.memory);
+        std::swap(m_call_frames, task.call_frames);
+        m_call_frame_ptr = m_call_frames.data() + std::exchange(task.call_frame_top, running_frame_top);
+
+        task.rfi = std::exchange(m_rfi, task.rfi);
+        task.rip = std::exchange(m_rip, task.rip);
+        task.rbp = std::exchange(m_rbp, task.rbp);
+        task.rft = std::exchange(m_rft, task.rft);
+        task.reg_high_water = std::exchange(m_reg_high_water, task.reg_high_water);
+        task.rrd = std::exchange(m_rrd, task.rrd);
+        task.is_home = std::exchange(m_on_home_task, task.is_home);
+    }
 
-            // std::println("RFI = {}, RIP = {}, RBP = {}, RFT = {}, RSP = {}, opcode: {}", m_rfi, m_rip, m_rbp, m_rft, m_rsp, Code::opcode_name(opcode)); // debug
+    /// NOTE: Moves the running task to the back of the ready queue & runs the task at its front.
+    void Engine::switch_task() {
+        Task next = m_tasks.pop_ready();
 
-            switch (opcode) {
-                case Code::Opcode::nop:
-                    ++m_rip;
-                    break;
-                case Code::Opcode::make_seq:
-                    handle_make_seq(args[0]);
-                    break;
-                case Code::Opcode::seq_obj_push:
-                    handle_seq_obj_push(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::seq_obj_pop:
-                    handle_seq_obj_pop(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::seq_obj_get:
-                    handle_seq_obj_get(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::frz_seq_obj:
-                    handle_frz_seq_obj(args[0]);
-                    break;
-                case Code::Opcode::load_const:
-                    handle_load_const(metadata, args[0], args[1]);
-                    break;
-                case Code::Opcode::mov:
-                    handle_mov(metadata, args[0], args[1]);
-                    break;
-                case Code::Opcode::neg:
-                    handle_neg(metadata, args[0]);
-                    break;
-                case Code::Opcode::inc:
-                    handle_inc(metadata, args[0]);
-                    break;
-                case Code::Opcode::dec:
-                    handle_dec(metadata, args[0]);
-                    break;
-                case Code::Opcode::mul:
-                    handle_mul(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::div:
-                    handle_div(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::mod:
-                    handle_mod(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::add:
-                    handle_add(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::sub:
-                    handle_sub(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::equ:
-                    handle_cmp_eq(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::neq:
-                    handle_cmp_ne(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::lt:
-                    handle_cmp_lt(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::gt:
-                    handle_cmp_gt(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::lte:
-                    handle_cmp_lte(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::gte:
-                    handle_cmp_gte(metadata, args[0], args[1], args[2]);
-                    break;
-                case Code::Opcode::jump:
-                    m_rip = args[0];
-                    break;
-                case Code::Opcode::jump_if:
-                    handle_jmp_if(args[0], args[1]);
-                    break;
-                case Code::Opcode::jump_else:
-                    handle_jmp_else(args[0], args[1]);
-                    break;
-                case Code::Opcode::call:
-                    handle_call(args[0], args[1]);
-                    break;
-                case Code::Opcode::ret:
-                    handle_ret(metadata, args[0]);
+        swap_task(next);
+        m_tasks.push_ready(std::move(next));
+    }
+
+    /// NOTE: Runs the next ready task in place of a spawned task which returned. The home task is always ready at this point since it is the only task whose return ends the run.
+    void Engine::finish_task() {
+        Task next = m_tasks.pop_ready();
+
+        swap_task(next);
+        m_tasks.recycle(std::move(next));
+    }
+
+    /// NOTE: Drops all spawned tasks, bringing back the home task's storage if a spawned task was running.
+    void Engine::restore_home_task() {
+        if (!m_on_home_task) {
+            if (auto home_opt = m_tasks.take_home(); home_opt) {
+                swap_task(home_opt.value());
+                m_tasks.recycle(std::move(home_opt.value()));
+            }
+        }
+
+        m_tasks.reset();
+    }
+
+    void Engine::count_call(int16_t func_id) noexcept {
+        if (m_jit_threshold > 0 && m_call_counts[func_id] < m_jit_threshold) {
+            ++m_call_counts[func_id];
+        }
+    }
+
+    /**
+     * @brief Gets the compiled code of a function, compiling it once its call count reaches the JIT threshold. A chunk which fails to compile is never retried.
+     */
+    auto Engine::prepare_jit(int16_t func_id) -> JIT::JitEntry {
+        if (auto jit_entry = m_jit_chunks[func_id].entry(); jit_entry != nullptr) {
+            return jit_entry;
+        }
+
+        if (m_call_counts[func_id] != m_jit_threshold) {
+            return nullptr;
+        }
+
+        m_call_counts[func_id] = m_jit_threshold + 1;
+
+        if (auto compiled_opt = JIT::compile_chunk(m_chunk_view[func_id], &Engine::step_instruction); compiled_opt) {
+            m_jit_chunks[func_id] = std::move(compiled_opt.value());
+        }
+
+        return m_jit_chunks[func_id].entry();
+    }
+
+    /**
+     * @brief Runs one iteration of a hot loop from its header while recording it, then compiles the recording into a trace for the header. The iteration stops before its closing back-edge, so the dispatch loop takes that jump & enters the new trace. Recording gives up at calls, returns, task switches, and inner loops, after which the header must get hot again. Headers which keep failing stay interpreted.
+     * @return The IP where the interpreter continues.
+     */
+    auto Engine::record_trace(FastValue* frame, int header_ip) -> int {
+        const Code::Instruction* code = m_chunk_view[m_rfi].data();
+        auto& header = m_header_slots[m_rfi][header_ip];
+        Trace::TraceRecorder recorder {header_ip};
+        int ip = header_ip;
+
+        while (true) {
+            const auto [next_ip, action] = recorder.record(ip, code[ip], frame, m_const_view);
+
+            switch (action) {
+                case Trace::RecordAction::step:
+                    if (!step_instruction(this, frame, code + ip)) {
+                        return ip;
+                    }
+                    ip = next_ip;
                     break;
-                case Code::Opcode::native_call:
-                    handle_native_call(args[0], args[1]);
+                case Trace::RecordAction::jump:
+                    ip = next_ip;
                     break;
-                case Code::Opcode::halt:
+                case Trace::RecordAction::close:
+                    if (m_traces.size() < static_cast<std::size_t>(std::numeric_limits<int16_t>::max())) {
+                        header.trace_id = static_cast<int16_t>(m_traces.size());
+                        m_traces.emplace_back(recorder.compile(m_const_view));
+                    }
+                    return next_ip;
+                case Trace::RecordAction::abort:
                 default:
-                    m_res = static_cast<int>(Utils::ExecStatus::op_error);
-                    break;
+                    header.hits = (++header.failures < trace_max_failures) ? 0 : m_trace_threshold;
+                    return next_ip;
             }
         }
+    }
+
+    /**
+     * @brief Runs one instruction for compiled code or a trace through the same handlers as the dispatch loop. Quickened & int32 forms take their generic handlers, which give the same results.
+     */
+    auto Engine::step_instruction(void* engine_p, FastValue* frame, const Code::Instruction* inst) noexcept -> bool {
+        auto& self = *static_cast<Engine*>(engine_p);
+        const auto& [args, metadata, opcode] = *inst;
+        const FastValue* consts = self.m_const_view;
+
+        switch (Code::generic_opcode(opcode)) {
+            case Code::Opcode::make_seq: self.handle_make_seq(frame, args[0]); break;
+            case Code::Opcode::seq_obj_push: self.handle_seq_obj_push(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::seq_obj_pop: self.handle_seq_obj_pop(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::seq_obj_get: self.handle_seq_obj_get(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::frz_seq_obj: self.handle_frz_seq_obj(frame, args[0]); break;
+            case Code::Opcode::seq_len: self.handle_seq_len(frame, metadata, args[0], args[1]); break;
+            case Code::Opcode::load_const: self.handle_load_const(frame, metadata, args[0], args[1]); break;
+            case Code::Opcode::mov: self.handle_mov(frame, metadata, args[0], args[1]); break;
+            case Code::Opcode::neg: self.handle_neg(frame, metadata, args[0]); break;
+            case Code::Opcode::inc: self.handle_inc(frame, metadata, args[0]); break;
+            case Code::Opcode::dec: self.handle_dec(frame, metadata, args[0]); break;
+            case Code::Opcode::add_assign: frame[args[0]] += operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]); break;
+            case Code::Opcode::sub_assign: frame[args[0]] -= operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]); break;
+            case Code::Opcode::mul: self.handle_mul(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::div: self.handle_div(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::mod: self.handle_mod(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::add: self.handle_add(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::sub: self.handle_sub(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::equ: self.handle_cmp_eq(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::neq: self.handle_cmp_ne(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::lt: self.handle_cmp_lt(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::gt: self.handle_cmp_gt(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::lte: self.handle_cmp_lte(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::gte: self.handle_cmp_gte(frame, metadata, args[0], args[1], args[2]); break;
+            case Code::Opcode::native_call: self.handle_native_call(args[0], args[1], args[2]); break;
+            default:
+                self.m_res = static_cast<int>(Utils::ExecStatus::op_error);
+                break;
+        }
+
+        return self.m_res == ok_res_value;
+    }
+
+    auto Engine::find_function(const std::string& name) const noexcept -> std::optional<int16_t> {
+        if (auto func_id_it = m_function_ids->find(name); func_id_it != m_function_ids->end()) {
+            return func_id_it->second;
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief Runs a function with host-supplied arguments until it returns. The registers, call frames, and heap are reset in place beforehand, so heap objects from a previous result must not be used after this.
+     *
+     * @param func_id
+     * @param args Scalar arguments, matching the function's parameter count.
+     * @return The function's result if the run finished, or else just its status. A `suspended` run continues through `resume()`.
+     */
+    auto Engine::invoke(int16_t func_id, std::span<const FastValue> args) -> Utils::InvokeResult {
+        if (!m_setup_ok) {
+            return {.value = {}, .status = Utils::ExecStatus::setup_error};
+        }
+
+        if (func_id < 0 || func_id >= m_funcs_n || static_cast<int>(args.size()) != m_frame_view[func_id].param_count) {
+            return {.value = {}, .status = Utils::ExecStatus::arg_error};
+        }
+
+        /// NOTE: Object arguments would refer to a heap which is cleared right below.
+        if (std::ranges::any_of(args, [](const FastValue& arg) { return arg.tag() == FVTag::sequence || arg.tag() == FVTag::val_ref; })) {
+            return {.value = {}, .status = Utils::ExecStatus::arg_error};
+        }
+
+        restore_home_task();
+
+        if (!fit_registers(frame_top_of(func_id, 0))) {
+            return {.value = {}, .status = Utils::ExecStatus::stack_overflow};
+        }
+
+        m_heap.reset();
+        clear_dead_registers(m_memory.data(), -1, m_reg_high_water);
+        std::ranges::copy(args, m_memory.begin());
+
+        enter_function(func_id);
+        m_res = ok_res_value;
+
+        return resume();
+    }
+
+    auto Engine::invoke(const std::string& name, std::span<const FastValue> args) -> Utils::InvokeResult {
+        if (auto func_id_opt = find_function(name); func_id_opt) {
+            return invoke(func_id_opt.value(), args);
+        }
+
+        return {.value = {}, .status = Utils::ExecStatus::arg_error};
+    }
+
+    auto Engine::resume() -> Utils::InvokeResult {
+        const auto run_status = dispatch();
+
+        return {
+            .value = (run_status == Utils::ExecStatus::ok) ? m_memory[0] : FastValue {},
+            .status = run_status,
+        };
+    }
 
-        if (m_res != ok_res_value) {
-            return static_cast<Utils::ExecStatus>(m_res);
+    auto Engine::operator()() -> Utils::ExecStatus {
+        const auto run_status = dispatch();
+
+        if (run_status != Utils::ExecStatus::ok) {
+            return run_status;
         }
 
         return (m_memory[0] == FastValue {0}) ? Utils::ExecStatus::ok : Utils::ExecStatus::user_error;
     }
 
-    auto Engine::handle_native_fn_access(int16_t arg_count, int16_t offset) & noexcept -> Runtime::FastValue& {
-        const auto native_call_base_slot = m_rft - arg_count + 1;
+#if MINUET_VM_THREADED_DISPATCH
+    /// NOTE: labels-as-values and computed gotos are GNU extensions, so `-Wpedantic` must look away from the dispatch loop only.
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+    auto Engine::dispatch() -> Utils::ExecStatus {
+#if MINUET_VM_THREADED_DISPATCH
+        /// NOTE: Must match the declaration order of `Code::Opcode` since the opcode byte indexes this table directly.
+        static const void* const dispatch_table[] = {
+            &&op_nop,
+            &&op_make_seq,
+            &&op_seq_obj_push,
+            &&op_seq_obj_pop,
+            &&op_seq_obj_get,
+            &&op_frz_seq_obj,
+            &&op_seq_len,
+            &&op_load_const,
+            &&op_mov,
+            &&op_neg,
+            &&op_inc,
+            &&op_dec,
+            &&op_add_assign,
+            &&op_sub_assign,
+            &&op_mul,
+            &&op_div,
+            &&op_mod,
+            &&op_add,
+            &&op_sub,
+            &&op_equ,
+            &&op_neq,
+            &&op_lt,
+            &&op_gt,
+            &&op_lte,
+            &&op_gte,
+            &&op_jump,
+            &&op_jump_if,
+            &&op_jump_else,
+            &&op_jeq,
+            &&op_jne,
+            &&op_jlt,
+            &&op_jgt,
+            &&op_jle,
+            &&op_jge,
+            &&op_jnlt,
+            &&op_jngt,
+            &&op_jnle,
+            &&op_jnge,
+            &&op_call,
+            &&op_tail_call,
+            &&op_native_call,
+            &&op_spawn,
+            &&op_yield,
+            &&op_ret,
+            &&op_halt,
+            &&op_mul_rr,
+            &&op_mul_rc,
+            &&op_mul_cr,
+            &&op_div_rr,
+            &&op_div_rc,
+            &&op_div_cr,
+            &&op_mod_rr,
+            &&op_mod_rc,
+            &&op_mod_cr,
+            &&op_add_rr,
+            &&op_add_rc,
+            &&op_add_cr,
+            &&op_sub_rr,
+            &&op_sub_rc,
+            &&op_sub_cr,
+            &&op_equ_rr,
+            &&op_equ_rc,
+            &&op_equ_cr,
+            &&op_neq_rr,
+            &&op_neq_rc,
+            &&op_neq_cr,
+            &&op_lt_rr,
+            &&op_lt_rc,
+            &&op_lt_cr,
+            &&op_gt_rr,
+            &&op_gt_rc,
+            &&op_gt_cr,
+            &&op_lte_rr,
+            &&op_lte_rc,
+            &&op_lte_cr,
+            &&op_gte_rr,
+            &&op_gte_rc,
+            &&op_gte_cr,
+            &&op_add_i32,
+            &&op_sub_i32,
+            &&op_mul_i32,
+            &&op_lt_i32,
+        };
+
+        static_assert(std::size(dispatch_table) == static_cast<std::size_t>(Code::Opcode::last));
+#endif
+
+        if (m_rrd <= 0 || m_res != ok_res_value) {
+            return (m_res != ok_res_value) ? static_cast<Utils::ExecStatus>(m_res) : Utils::ExecStatus::ok;
+        }
+
+        /// NOTE: The VM registers live in locals across dispatch so that the compiler can keep them out of memory. Only handlers which observe the whole VM state (calls, returns, natives) see them spilled back into the members.
+        Code::Instruction* code = m_chunk_view[m_rfi].data();
+        Code::SiteFeedback* sites = (m_feedback_view != nullptr) ? m_feedback_view[m_rfi].data() : nullptr;
+        Trace::HeaderSlot* headers = (m_trace_threshold > 0) ? m_header_slots[m_rfi].data() : nullptr;
+        const FastValue* consts = m_const_view;
+        FastValue* frame = m_memory.data() + m_rbp;
+        int rip = m_rip;
+        int rbp = m_rbp;
+        /// NOTE: Each run gets a fresh slice, and a suspended run resumes from the spilled registers on the next call. The running task's quantum carries over between runs, so that small slices still rotate tasks. Ticks are charged in windows that end at whichever runs out first.
+        const int64_t task_quantum = (m_task_quantum > 0) ? m_task_quantum : std::numeric_limits<int64_t>::max();
+        int64_t slice_left = (m_slice_budget > 0) ? m_slice_budget : std::numeric_limits<int64_t>::max();
+        int64_t quantum_left = m_quantum_left;
+        int64_t tick_window = std::min(slice_left, quantum_left);
+        int64_t ticks_left = tick_window;
+        JIT::JitEntry jit_entry = nullptr;
+
+        MINUET_VM_TRY_JIT();
+
+    vm_resume:
+#if MINUET_VM_THREADED_DISPATCH
+        MINUET_VM_NEXT();
+        {
+#else
+        while (true) {
+            switch (code[rip].op) {
+#endif
+            MINUET_VM_OP(nop):
+                ++rip;
+                MINUET_VM_NEXT();
+            MINUET_VM_OP(make_seq):
+                handle_make_seq(frame, code[rip].args[0]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            MINUET_VM_OP(seq_obj_push): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_seq_obj_push(frame, metadata, args[0], args[1], args[2]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(seq_obj_pop): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_seq_obj_pop(frame, metadata, args[0], args[1], args[2]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(seq_obj_get): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_seq_obj_get(frame, metadata, args[0], args[1], args[2]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(frz_seq_obj):
+                handle_frz_seq_obj(frame, code[rip].args[0]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            MINUET_VM_OP(seq_len): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_seq_len(frame, metadata, args[0], args[1]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(load_const): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_load_const(frame, metadata, args[0], args[1]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(mov): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_mov(frame, metadata, args[0], args[1]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(neg): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_neg(frame, metadata, args[0]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(inc): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_inc(frame, metadata, args[0]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(dec): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_dec(frame, metadata, args[0]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(add_assign): {
+                const auto& [args, metadata, opcode] = code[rip];
+                frame[args[0]] += operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(sub_assign): {
+                const auto& [args, metadata, opcode] = code[rip];
+                frame[args[0]] -= operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(mul): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_OBSERVE_SITE(mul_i32, operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]), operand_of(frame, consts, arg_mode_of<2>(metadata), args[2]));
+                handle_mul(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(div): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_div(frame, metadata, args[0], args[1], args[2]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(mod): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_mod(frame, metadata, args[0], args[1], args[2]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(add): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_OBSERVE_SITE(add_i32, operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]), operand_of(frame, consts, arg_mode_of<2>(metadata), args[2]));
+                handle_add(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(sub): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_OBSERVE_SITE(sub_i32, operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]), operand_of(frame, consts, arg_mode_of<2>(metadata), args[2]));
+                handle_sub(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(equ): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_cmp_eq(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(neq): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_cmp_ne(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(lt): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_OBSERVE_SITE(lt_i32, operand_of(frame, consts, arg_mode_of<1>(metadata), args[1]), operand_of(frame, consts, arg_mode_of<2>(metadata), args[2]));
+                handle_cmp_lt(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(gt): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_cmp_gt(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(lte): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_cmp_lte(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(gte): {
+                const auto& [args, metadata, opcode] = code[rip];
+                handle_cmp_gte(frame, metadata, args[0], args[1], args[2]);
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(jump): {
+                const int jump_from = rip;
+                rip = code[rip].args[0];
+                MINUET_VM_CHECK_BACK_EDGE(jump_from);
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(jump_if): {
+                const auto& [args, metadata, opcode] = code[rip];
+                const int jump_from = rip;
+                rip = (frame[args[0]]) ? args[1] : rip + 1;
+                MINUET_VM_CHECK_BACK_EDGE(jump_from);
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(jump_else): {
+                const auto& [args, metadata, opcode] = code[rip];
+                const int jump_from = rip;
+                rip = (!frame[args[0]]) ? args[1] : rip + 1;
+                MINUET_VM_CHECK_BACK_EDGE(jump_from);
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_FUSED_BRANCH(jeq, ==, false)
+            MINUET_VM_FUSED_BRANCH(jne, ==, true)
+            MINUET_VM_FUSED_BRANCH(jlt, <, false)
+            MINUET_VM_FUSED_BRANCH(jgt, >, false)
+            MINUET_VM_FUSED_BRANCH(jle, <=, false)
+            MINUET_VM_FUSED_BRANCH(jge, >=, false)
+            MINUET_VM_FUSED_BRANCH(jnlt, <, true)
+            MINUET_VM_FUSED_BRANCH(jngt, >, true)
+            MINUET_VM_FUSED_BRANCH(jnle, <=, true)
+            MINUET_VM_FUSED_BRANCH(jnge, >=, true)
+            MINUET_VM_OP(call): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_SPILL_REGS();
+                handle_call(args[0], args[1], args[2]);
+                MINUET_VM_RELOAD_REGS();
+                MINUET_VM_CHECK_STATUS();
+                MINUET_VM_CHARGE_SLICE(1);
+                MINUET_VM_TRY_JIT();
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(tail_call): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_SPILL_REGS();
+                handle_tail_call(args[0], args[1], args[2]);
+                MINUET_VM_RELOAD_REGS();
+                MINUET_VM_CHECK_STATUS();
+                MINUET_VM_CHARGE_SLICE(1);
+                MINUET_VM_TRY_JIT();
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(native_call): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_SPILL_REGS();
+                handle_native_call(args[0], args[1], args[2]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(spawn): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_SPILL_REGS();
+                handle_spawn(args[0], args[1], args[2]);
+                MINUET_VM_CHECK_STATUS();
+                ++rip;
+                MINUET_VM_CHARGE_SLICE(1);
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_OP(yield):
+                ++rip;
+                quantum_left = 0;
+                MINUET_VM_SPILL_REGS();
+                goto vm_preempt;
+            MINUET_VM_OP(ret): {
+                const auto& [args, metadata, opcode] = code[rip];
+                MINUET_VM_SPILL_REGS();
+                handle_ret(metadata, args[0]);
+
+                if (m_res != ok_res_value) {
+                    goto vm_exit;
+                }
+
+                /// NOTE: The run ends once the home task returns, dropping any unfinished tasks. A spawned task's return just passes control to the next one.
+                if (m_rrd <= 0) {
+                    if (m_on_home_task) {
+                        m_tasks.reset();
+                        goto vm_exit;
+                    }
+
+                    finish_task();
+                }
+
+                MINUET_VM_RELOAD_REGS();
+                MINUET_VM_TRY_JIT();
+                MINUET_VM_NEXT();
+            }
+            MINUET_VM_QUICK_ARITH(mul_rr, mul_i32, *=, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_ARITH(mul_rc, mul_i32, *=, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_ARITH(mul_cr, mul_i32, *=, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_DIVIDE(div_rr, /, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_DIVIDE(div_rc, /, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_DIVIDE(div_cr, /, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_DIVIDE(mod_rr, %, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_DIVIDE(mod_rc, %, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_DIVIDE(mod_cr, %, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_ARITH(add_rr, add_i32, +=, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_ARITH(add_rc, add_i32, +=, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_ARITH(add_cr, add_i32, +=, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_ARITH(sub_rr, sub_i32, -=, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_ARITH(sub_rc, sub_i32, -=, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_ARITH(sub_cr, sub_i32, -=, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(equ_rr, last, ==, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(equ_rc, last, ==, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_COMPARE(equ_cr, last, ==, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(neq_rr, last, !=, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(neq_rc, last, !=, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_COMPARE(neq_cr, last, !=, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(lt_rr, lt_i32, <, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(lt_rc, lt_i32, <, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_COMPARE(lt_cr, lt_i32, <, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(gt_rr, last, >, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(gt_rc, last, >, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_COMPARE(gt_cr, last, >, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(lte_rr, last, <=, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(lte_rc, last, <=, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_COMPARE(lte_cr, last, <=, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(gte_rr, last, >=, MINUET_VM_R, MINUET_VM_R)
+            MINUET_VM_QUICK_COMPARE(gte_rc, last, >=, MINUET_VM_R, MINUET_VM_C)
+            MINUET_VM_QUICK_COMPARE(gte_cr, last, >=, MINUET_VM_C, MINUET_VM_R)
+            MINUET_VM_INT32_OP(add_i32, handle_add, lhs_i32 + rhs_i32)
+            MINUET_VM_INT32_OP(sub_i32, handle_sub, lhs_i32 - rhs_i32)
+            MINUET_VM_INT32_OP(mul_i32, handle_mul, lhs_i32 * rhs_i32)
+            MINUET_VM_INT32_OP(lt_i32, handle_cmp_lt, lhs_i32 < rhs_i32)
+            MINUET_VM_OP(halt):
+#if !MINUET_VM_THREADED_DISPATCH
+            default:
+#endif
+                m_res = static_cast<int>(Utils::ExecStatus::op_error);
+                MINUET_VM_SPILL_REGS();
+                goto vm_exit;
+#if MINUET_VM_THREADED_DISPATCH
+        }
+#else
+            }
+        }
+#endif
+
+    vm_preempt:
+        /// NOTE: The tick window ran out or the task yielded, so the ticks it used come off both the slice & the quantum. A spent quantum passes control to the next ready task (if any) before a spent slice suspends the run.
+        slice_left -= tick_window - ticks_left;
+        quantum_left -= tick_window - ticks_left;
+
+        if (quantum_left <= 0) {
+            if (m_tasks.has_ready()) {
+                switch_task();
+            }
+
+            quantum_left = task_quantum;
+        }
+
+        if (slice_left <= 0) {
+            m_quantum_left = quantum_left;
+            goto vm_suspend;
+        }
+
+        tick_window = std::min(slice_left, quantum_left);
+        ticks_left = tick_window;
+        MINUET_VM_RELOAD_REGS();
+        MINUET_VM_TRY_JIT();
+        goto vm_resume;
+
+    vm_jit:
+        /// NOTE: Compiled code runs the current function from `rip` until an instruction it leaves to the interpreter (calls, returns, task switches), a failed handler, or the end of the tick window.
+        MINUET_VM_SPILL_REGS();
+        m_jit_ctx.ticks_left = ticks_left;
+        m_jit_ctx.engine = this;
+        m_jit_ctx.consts = consts;
+        rip = jit_entry(&m_jit_ctx, frame, rip);
+        ticks_left = m_jit_ctx.ticks_left;
+        MINUET_VM_CHECK_STATUS();
+
+        if (ticks_left <= 0) {
+            MINUET_VM_SPILL_REGS();
+            goto vm_preempt;
+        }
+
+        goto vm_resume;
+
+    vm_trace:
+        /// NOTE: A trace runs until one of its side exits, a failed step, or the end of the tick window, which it leaves at the loop header.
+        MINUET_VM_SPILL_REGS();
+        rip = Trace::run_trace(m_traces[headers[rip].trace_id], code, frame, consts, ticks_left, &Engine::step_instruction, this);
+        MINUET_VM_CHECK_STATUS();
+
+        if (ticks_left <= 0) {
+            MINUET_VM_SPILL_REGS();
+            goto vm_preempt;
+        }
+
+        goto vm_resume;
+
+    vm_record:
+        MINUET_VM_SPILL_REGS();
+        rip = record_trace(frame, rip);
+        MINUET_VM_CHECK_STATUS();
+        goto vm_resume;
+
+    vm_suspend:
+        return Utils::ExecStatus::suspended;
+
+    vm_exit:
+        return static_cast<Utils::ExecStatus>(m_res);
+    }
+
+#if MINUET_VM_THREADED_DISPATCH
+    #pragma GCC diagnostic pop
+#endif
 
-        return m_memory[native_call_base_slot + offset];
+    auto Engine::handle_native_fn_access([[maybe_unused]] int16_t arg_count, int16_t offset) & noexcept -> Runtime::FastValue& {
+        return m_memory[m_native_base + offset];
     }
 
     void Engine::handle_native_fn_return(Runtime::FastValue&& result, [[maybe_unused]] int16_t arg_count) noexcept {
-        const auto native_call_base_slot = m_rft - arg_count + 1;
+        m_memory[m_native_base] = std::move(result);
+    }
 
-        m_memory[native_call_base_slot] = std::move(result);
+    void Engine::handle_native_fn_store(Runtime::HeapValueBase& target, const Runtime::FastValue& item) noexcept {
+        m_heap.note_store(target, item);
     }
 
+    auto Engine::handle_native_fn_push(HeapValueBase& target, const FastValue& item) noexcept -> bool {
+        return push_counted(target, item);
+    }
 
-    /**
-     * @brief Implements the bulk of garbage collection. Specifically, the logic will base itself on craftinginterpreters.com: the GC will stop-the-world for each collection if the heap has a certain "overhead score" given by
-     */
-    void Engine::try_mark_and_sweep() {
-        if (!m_heap.is_ripe()) {
-            return;
-        }
+    auto Engine::gc_pause_stats() const noexcept -> const Utils::GCPauseStats& {
+        return m_gc_pauses;
+    }
+
+    auto Engine::object_slab_stats() const noexcept -> Runtime::AllocatorStats {
+        return m_heap.get_object_slab_stats();
+    }
 
-        std::set<HeapValuePtr> live_object_ptrs;
-        std::set<HeapValuePtr> visited;
-        std::queue<HeapValuePtr> frontier;
+    auto Engine::payload_pool_stats() const noexcept -> Runtime::AllocatorStats {
+        return m_heap.get_payload_pool_stats();
+    }
+
+    auto Engine::heap_census(std::size_t largest_count) -> Runtime::HeapCensus {
+        return m_heap.take_census(largest_count);
+    }
 
-        for (auto abs_reg_id = 0; abs_reg_id <= m_rft; ++abs_reg_id) {
-            if (HeapValuePtr object_p = m_memory[abs_reg_id].to_object_ptr(); object_p) {
-                frontier.emplace(object_p);
+    auto Engine::write_heap_snapshot(std::ostream& out) -> bool {
+        std::vector<HeapValuePtr> roots;
+
+        auto add_roots = [&roots](FastValue* registers, int top_reg) {
+            for (auto abs_reg_id = 0; abs_reg_id <= top_reg; ++abs_reg_id) {
+                if (HeapValuePtr object_p = registers[abs_reg_id].to_object_ptr(); object_p) {
+                    roots.emplace_back(object_p);
+                }
             }
+        };
+
+        add_roots(m_memory.data(), m_rft);
+
+        for (auto& task : m_tasks.ready_tasks()) {
+            add_roots(task.memory.data(), task.rft);
         }
 
-        // 1. Use a BFS traversal to mark all heap values that are reachable from the register frames. During this stage, every marked address will be stored in a "reachable" set...
-        while (!frontier.empty()) {
-            auto next_ptr = frontier.front();
-            frontier.pop();
+        return m_heap.write_snapshot(out, roots);
+    }
+
+    void Engine::set_gc_observer(Utils::gc_observer_t observer, void* context, std::size_t largest_count) noexcept {
+        m_gc_observer = observer;
+        m_gc_observer_context = context;
+        m_gc_census_top = largest_count;
+    }
 
-            live_object_ptrs.emplace(next_ptr);
 
-            if (next_ptr->get_tag() == ObjectTag::sequence) {
-                SequenceValue* sequence_ptr = dynamic_cast<SequenceValue*>(next_ptr);
+    /**
+     * @brief Implements the bulk of garbage collection. Specifically, the logic will base itself on craftinginterpreters.com: a full collection starts once the heap has a certain "overhead score", which only allocation safepoints check. Marking sets the mark bit of each object header through an explicit mark stack, and the sweep frees only unmarked objects. With a `gc_max_pause`, each call only runs one step of the collection until that time is up, so the rest resumes at later safepoints. Otherwise the whole collection stops the world.
+     */
+    void Engine::try_mark_and_sweep() noexcept {
+        using GCClock = std::chrono::steady_clock;
 
-                for (auto& item_value : sequence_ptr->items()) {
-                    if (HeapValuePtr item_obj_ptr = item_value.to_object_ptr(); item_obj_ptr != nullptr && !visited.contains(item_obj_ptr)) {
-                        frontier.emplace(item_obj_ptr);
-                    }
+        const auto step_start = GCClock::now();
+        auto step_ns = [step_start]() noexcept -> int64_t {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(GCClock::now() - step_start).count();
+        };
+        auto out_of_time = [this, &step_ns]() noexcept {
+            return m_gc_max_pause_ns > 0 && step_ns() >= m_gc_max_pause_ns;
+        };
+        bool shared_step = false;
+
+        // 1. Mark the objects held by live registers of every task. Suspended green threads share the heap, so their register windows are roots too.
+        if (m_heap.gc_phase() == GCPhase::idle) {
+            m_heap.begin_marking();
+            mark_roots();
+        }
+
+        // 2. Mark everything reachable from those roots. Between steps, the write barrier shades stored objects, but registers are not tracked, so the final marking step marks them again in one pause. Stopping the world skips straight to that step, which may share the tracing among threads.
+        if (m_heap.gc_phase() == GCPhase::marking) {
+            while (m_gc_max_pause_ns > 0 && !m_heap.trace_some(cm_gc_trace_unit)) {
+                if (out_of_time()) {
+                    record_gc_pause(step_ns(), true);
+                    return;
                 }
             }
 
-            visited.emplace(next_ptr);
+            mark_roots();
+            shared_step = m_heap.trace_all(m_gc_threads);
+            m_heap.begin_sweep();
+
+            // 3. Registers above each frame top may still hold objects to be swept, which a later frame could read as roots before writing them.
+            clear_all_dead_registers();
         }
 
-        // 2. Linearly scan through the heap cells for anything NOT in the reachable set... If the value is unmarked, the VM can collect it.
-        for (auto cell_id = 0UL; auto& heap_cell : m_heap.get_objects()) {
-            if (heap_cell.get()->get_tag() != ObjectTag::dud) {
-                if (!m_heap.try_destroy_value(cell_id)) {
+        // 4. Return each unmarked slot to the heap's free list.
+        if (m_gc_max_pause_ns == 0) {
+            shared_step = m_heap.sweep_all(m_gc_threads) || shared_step;
+        } else {
+            while (!m_heap.sweep_some(cm_gc_sweep_unit)) {
+                if (out_of_time()) {
                     break;
                 }
             }
+        }
+
+        record_gc_pause(step_ns(), true);
+
+        if (shared_step) {
+            ++m_gc_pauses.parallel_steps;
+        }
+
+        if (m_heap.gc_phase() == GCPhase::idle) {
+            ++m_gc_pauses.full_collections;
+        }
+
+        /// NOTE: The census runs outside the recorded pause, right after the sweep which left only live objects.
+        if (m_gc_observer && m_heap.gc_phase() == GCPhase::idle) {
+            m_gc_observer(m_heap.take_census(m_gc_census_top), m_gc_observer_context);
+        }
+    }
+
+    void Engine::mark_roots() noexcept {
+        mark_registers(m_memory.data(), m_rft);
+
+        for (auto& task : m_tasks.ready_tasks()) {
+            mark_registers(task.memory.data(), task.rft);
+        }
+    }
+
+    void Engine::clear_all_dead_registers() noexcept {
+        clear_dead_registers(m_memory.data(), m_rft, m_reg_high_water);
+
+        for (auto& task : m_tasks.ready_tasks()) {
+            clear_dead_registers(task.memory.data(), task.rft, task.reg_high_water);
+        }
+    }
+
+    void Engine::record_gc_pause(int64_t pause_ns, bool full_step) noexcept {
+        const auto bucket_id = std::min<int>(std::bit_width(static_cast<uint64_t>(pause_ns / 1000)), Utils::GCPauseStats::bucket_count - 1);
+
+        ++m_gc_pauses.buckets[bucket_id];
+        ++m_gc_pauses.count;
+        m_gc_pauses.total_ns += pause_ns;
+        m_gc_pauses.max_ns = std::max(m_gc_pauses.max_ns, pause_ns);
+
+        if (full_step) {
+            ++m_gc_pauses.full_steps;
+            m_gc_pauses.full_step_max_ns = std::max(m_gc_pauses.full_step_max_ns, pause_ns);
+        }
+    }
+
+    /**
+     * @brief Promotes the young objects which registers of any task reach, then empties the nursery. Old sequences which the write barrier remembered count as roots too.
+     */
+    void Engine::collect_young() {
+        const auto minor_start = std::chrono::steady_clock::now();
+
+        forward_registers(m_memory.data(), m_rft);
+
+        for (auto& task : m_tasks.ready_tasks()) {
+            forward_registers(task.memory.data(), task.rft);
+        }
+
+        m_heap.finish_minor();
+        clear_all_dead_registers();
+
+        record_gc_pause(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - minor_start).count(), false);
+    }
+
+    void Engine::forward_registers(Runtime::FastValue* registers, int top_reg) {
+        for (auto abs_reg_id = 0; abs_reg_id <= top_reg; ++abs_reg_id) {
+            if (HeapValuePtr object_p = registers[abs_reg_id].to_object_ptr(); object_p && object_p->has_mark(ObjectMark::young)) {
+                registers[abs_reg_id] = FastValue {m_heap.promote(object_p)};
+            }
+        }
+    }
+
+    void Engine::clear_dead_registers(Runtime::FastValue* registers, int top_reg, int& high_water) noexcept {
+        if (high_water > top_reg) {
+            std::fill(registers + top_reg + 1, registers + high_water + 1, FastValue {});
+        }
+
+        high_water = std::max(top_reg, 0);
+    }
+
+    void Engine::mark_registers(Runtime::FastValue* registers, int top_reg) noexcept {
+        for (auto abs_reg_id = 0; abs_reg_id <= top_reg; ++abs_reg_id) {
+            if (HeapValuePtr object_p = registers[abs_reg_id].to_object_ptr(); object_p) {
+                m_heap.mark_object(object_p);
+            }
+        }
+    }
+
+    void Engine::handle_make_seq(FastValue* frame, int16_t dest_reg) noexcept {
+        /// NOTE: Allocations are the safepoints which start full collections & step them, so that collection keeps pace with the mutator however rarely it returns. Every live object is reachable from the registers up to `RFT` here.
+        if (m_heap.has_gc_work()) {
+            try_mark_and_sweep();
+        }
+
+        HeapValuePtr temp_obj_ref = m_heap.try_create_value(ObjectTag::sequence);
+
+        /// NOTE: A full nursery is a safepoint for a minor collection, since every live object is reachable from the registers up to `RFT` at this point.
+        if (!temp_obj_ref) {
+            collect_young();
+            temp_obj_ref = m_heap.try_create_value(ObjectTag::sequence);
+        }
+
+        if (!temp_obj_ref) {
+            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            return;
+        }
+
+        frame[dest_reg] = temp_obj_ref;
+    }
+
+    auto Engine::push_counted(HeapValueBase& target, FastValue item) noexcept -> bool {
+        if (target.get_tag() != ObjectTag::sequence || target.is_frozen()) {
+            return false;
+        }
+
+        m_heap.note_store(target, item);
+
+        auto& sequence = static_cast<SequenceValue&>(target);
+        const auto old_capacity = sequence.items().capacity();
+
+        if (!sequence.push_value(item)) {
+            return false;
+        }
 
-            ++cell_id;
+        if (const auto new_capacity = sequence.items().capacity(); new_capacity > old_capacity) {
+            m_heap.note_growth(sequence, (new_capacity - old_capacity) * sizeof(FastValue));
+            m_payload_grew = true;
         }
+
+        return true;
     }
 
-    void Engine::handle_make_seq(int16_t dest_reg) noexcept {
-        HeapValuePtr temp_obj_ref = m_heap.try_create_value(ObjectTag::sequence).get();
-        const auto abs_reg_id = m_rbp + dest_reg;
+    /// NOTE: A push which grew an item buffer allocated too, so it is a safepoint like `make_seq` once the pushed value is stored: right after `seq_obj_push`, or after the native call which pushed.
+    void Engine::poll_growth_safepoint() noexcept {
+        if (!m_payload_grew) {
+            return;
+        }
+
+        m_payload_grew = false;
 
-        m_memory[abs_reg_id] = temp_obj_ref;
+        if (m_heap.is_nursery_ripe()) {
+            collect_young();
+        }
 
-        ++m_rip;
+        if (m_heap.has_gc_work()) {
+            try_mark_and_sweep();
+        }
     }
 
-    void Engine::handle_seq_obj_push([[maybe_unused]] uint16_t metadata, int16_t dest, int16_t src_id, [[maybe_unused]] int16_t mode) noexcept {
-        const auto abs_dest_id = m_rbp + dest;
+    void Engine::handle_seq_obj_push(FastValue* frame, [[maybe_unused]] uint16_t metadata, int16_t dest, int16_t src_id, [[maybe_unused]] int16_t mode) noexcept {
         const auto src_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
 
-        auto src_value_opt = fetch_value(src_mode, src_id);
+        auto src_value_opt = fetch_value(frame, src_mode, src_id);
 
         if (!src_value_opt) {
             m_res = static_cast<int>(Utils::ExecStatus::mem_error);
@@ -244,37 +1327,41 @@ namespace Minuet::Runtime::VM {
 
         auto src_value = src_value_opt.value();
 
-        if (HeapValuePtr dest_obj_ref = m_memory[abs_dest_id].to_object_ptr(); dest_obj_ref) {
-            dest_obj_ref->push_value(src_value);
-            ++m_rip;
+        if (HeapValuePtr dest_obj_ref = frame[dest].to_object_ptr(); dest_obj_ref) {
+            /// NOTE: Bad targets report `op_error` like a failed `list_push_back` native call, since that call lowers to this opcode.
+            if (!push_counted(*dest_obj_ref, src_value)) {
+                m_res = static_cast<int>(Utils::ExecStatus::op_error);
+                return;
+            }
+
+            poll_growth_safepoint();
         } else {
-            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            m_res = static_cast<int>(Utils::ExecStatus::op_error);
         }
     }
 
-    void Engine::handle_seq_obj_pop([[maybe_unused]] uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept {
-        const auto abs_dest_id = m_rbp + dest;
-        const auto abs_src_id = m_rbp + src_id;
+    void Engine::handle_seq_obj_pop(FastValue* frame, [[maybe_unused]] uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept {
         const SequenceOpPolicy pop_mode = static_cast<SequenceOpPolicy>(mode);
 
-        HeapValuePtr src_obj_ptr = m_memory[abs_src_id].to_object_ptr();
+        HeapValuePtr src_obj_ptr = frame[src_id].to_object_ptr();
 
+        /// NOTE: Failures report `op_error` like the `list_pop_back` & `list_pop_front` natives which lower to this opcode. Popping an empty or frozen sequence gives no value.
         if (!src_obj_ptr) {
-            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            m_res = static_cast<int>(Utils::ExecStatus::op_error);
             return;
         }
 
-        m_memory[abs_dest_id] = src_obj_ptr->pop_value(pop_mode);
-
-        ++m_rip;
+        if (auto popped_value = src_obj_ptr->pop_value(pop_mode); !popped_value.is_none()) {
+            frame[dest] = popped_value;
+        } else {
+            m_res = static_cast<int>(Utils::ExecStatus::op_error);
+        }
     }
 
-    void Engine::handle_seq_obj_get([[maybe_unused]] uint16_t metadata, int16_t dest, int16_t src_id, int16_t pos_value_id) noexcept {
-        const auto abs_dest_id = m_rbp + dest;
-        const auto abs_src_id = m_rbp + src_id;
+    void Engine::handle_seq_obj_get(FastValue* frame, [[maybe_unused]] uint16_t metadata, int16_t dest, int16_t src_id, int16_t pos_value_id) noexcept {
         const auto pos_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
 
-        auto pos_value_opt = fetch_value(pos_mode, pos_value_id);
+        auto pos_value_opt = fetch_value(frame, pos_mode, pos_value_id);
 
         if (!pos_value_opt) {
             m_res = static_cast<int>(Utils::ExecStatus::arg_error);
@@ -290,10 +1377,11 @@ namespace Minuet::Runtime::VM {
 
         const auto pos_i32 = pos_i32_opt.value();
 
-        if (HeapValuePtr src_obj_ref = m_memory[abs_src_id].to_object_ptr(); src_obj_ref) {
-            if (auto item_opt = src_obj_ref->get_value(pos_i32); item_opt) {
-                m_memory[abs_dest_id] = {item_opt.value()};
-                ++m_rip;
+        if (HeapValuePtr src_obj_ref = frame[src_id].to_object_ptr(); src_obj_ref) {
+            auto item_opt = visit_object(*src_obj_ref, [pos_i32](auto& object) { return object.get_value(pos_i32); });
+
+            if (item_opt) {
+                frame[dest] = {item_opt.value()};
                 return;
             }
         }
@@ -301,270 +1389,281 @@ namespace Minuet::Runtime::VM {
         m_res = static_cast<int>(Utils::ExecStatus::mem_error);
     }
 
-    void Engine::handle_frz_seq_obj(int16_t dest) noexcept {
-        const auto abs_dest_id = m_rbp + dest;
+    void Engine::handle_seq_len(FastValue* frame, uint16_t metadata, int16_t dest, int16_t src_id) noexcept {
+        const auto src_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
+
+        auto src_value_opt = fetch_value(frame, src_mode, src_id);
 
-        if (HeapValuePtr obj_ref = m_memory[abs_dest_id].to_object_ptr(); obj_ref) {
-            obj_ref->freeze();
-            ++m_rip;
+        if (!src_value_opt) {
+            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            return;
+        }
+
+        if (HeapValuePtr src_obj_ref = src_value_opt.value().to_object_ptr(); src_obj_ref) {
+            frame[dest] = FastValue {visit_object(*src_obj_ref, [](const auto& object) noexcept { return object.get_size(); })};
+        } else {
+            /// NOTE: This matches the `op_error` of a failed `len_of` native call, which lowers to this opcode.
+            m_res = static_cast<int>(Utils::ExecStatus::op_error);
+        }
+    }
 
+    void Engine::handle_frz_seq_obj(FastValue* frame, int16_t dest) noexcept {
+        if (HeapValuePtr obj_ref = frame[dest].to_object_ptr(); obj_ref) {
+            obj_ref->freeze();
             return;
         }
 
         m_res = static_cast<int>(Utils::ExecStatus::mem_error);
     }
 
-    auto Engine::fetch_value(Code::ArgMode mode, int16_t id) noexcept -> std::optional<FastValue> {
+    auto Engine::fetch_value(const FastValue* frame, Code::ArgMode mode, int16_t id) noexcept -> std::optional<FastValue> {
         switch (mode) {
             case Code::ArgMode::constant: return m_const_view[id];
-            case Code::ArgMode::reg: return m_memory[m_rbp + id];
+            case Code::ArgMode::reg: return frame[id];
             case Code::ArgMode::stack:
             case Code::ArgMode::heap:
             default: return {};
         }
     }
 
-    void Engine::handle_load_const([[maybe_unused]] uint16_t metadata, int16_t dest, int16_t const_id) noexcept {
-        auto temp_const = fetch_value(Code::ArgMode::constant, const_id);
+    void Engine::handle_load_const(FastValue* frame, [[maybe_unused]] uint16_t metadata, int16_t dest, int16_t const_id) noexcept {
+        auto temp_const = fetch_value(frame, Code::ArgMode::constant, const_id);
 
         if (!temp_const) {
             m_res = static_cast<int>(Utils::ExecStatus::mem_error);
             return;
         }
 
-        const auto real_mem_dest_id = m_rbp + dest;
-
-        m_memory[real_mem_dest_id] = temp_const.value();
-        m_rft = std::max(m_rft, real_mem_dest_id);
-        ++m_rip;
+        frame[dest] = temp_const.value();
     }
 
-    void Engine::handle_mov(uint16_t metadata, int16_t dest, int16_t src) noexcept {
+    void Engine::handle_mov(FastValue* frame, uint16_t metadata, int16_t dest, int16_t src) noexcept {
         const auto src_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
-        auto src_value_opt = fetch_value(src_mode, src);
+        auto src_value_opt = fetch_value(frame, src_mode, src);
 
         if (!src_value_opt) {
             m_res = static_cast<int>(Utils::ExecStatus::mem_error);
             return;
         }
 
-        const auto real_mem_dest_id = m_rbp + dest;
-
         /// NOTE: If the register's FastValue is a primitive, replace it. But if the FastValue contains a reference to the actual value (e.g a list's item) then `FastValue::emplace_other()` is necessary.
-        if (auto& dest_ref = m_memory[real_mem_dest_id]; dest_ref.tag() != FVTag::val_ref) {
+        if (auto& dest_ref = frame[dest]; dest_ref.tag() != FVTag::val_ref) {
             dest_ref = std::move(src_value_opt.value());
-        } else if (!dest_ref.emplace_other(src_value_opt.value())) {
-            m_res = static_cast<int>(Utils::ExecStatus::mem_error);
-            return;
-        }
+        } else {
+            /// NOTE: The reference may point into an old sequence, which the write barrier cannot name.
+            if (HeapValuePtr src_obj_p = src_value_opt.value().to_object_ptr(); src_obj_p && src_obj_p->has_mark(ObjectMark::young)) {
+                m_heap.note_untracked_store();
+            }
 
-        m_rft = std::max(m_rft, real_mem_dest_id);
-        ++m_rip;
+            m_heap.shade(src_value_opt.value());
+
+            if (!dest_ref.emplace_other(src_value_opt.value())) {
+                m_res = static_cast<int>(Utils::ExecStatus::mem_error);
+            }
+        }
     }
 
-    void Engine::handle_neg([[maybe_unused]] uint16_t metadata, int16_t dest) noexcept {
-        if (const auto real_mem_dest_id = m_rbp + dest; m_memory[real_mem_dest_id].negate()) {
-            m_rft = std::max(m_rft, real_mem_dest_id);
+    void Engine::handle_neg(FastValue* frame, [[maybe_unused]] uint16_t metadata, int16_t dest) noexcept {
+        if (frame[dest].negate()) {
             m_res = static_cast<int>(Utils::ExecStatus::arg_error);
-            return;
         }
-
-        ++m_rip;
     }
 
-    /// TODO: implement this instruction later!
-    void Engine::handle_inc([[maybe_unused]] uint16_t metadata, [[maybe_unused]] int16_t dest) noexcept {
-        m_res = static_cast<int>(Utils::ExecStatus::op_error);
+    /// NOTE: Same as `x = x + 1`, so non-int32 values become duds just like through `add`.
+    void Engine::handle_inc(FastValue* frame, [[maybe_unused]] uint16_t metadata, int16_t dest) noexcept {
+        frame[dest] += FastValue {1};
     }
 
-    /// TODO: implement this instruction later!
-    void Engine::handle_dec([[maybe_unused]] uint16_t metadata, [[maybe_unused]] int16_t dest) noexcept {
-        m_res = static_cast<int>(Utils::ExecStatus::op_error);
+    /// NOTE: Same as `x = x - 1`, so non-int32 values become duds just like through `sub`.
+    void Engine::handle_dec(FastValue* frame, [[maybe_unused]] uint16_t metadata, int16_t dest) noexcept {
+        frame[dest] -= FastValue {1};
     }
 
-    void Engine::handle_mul(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_mul(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        const auto real_mem_loc = m_rbp + dest;
-        m_memory[real_mem_loc] = std::move(lhs_opt.value());
-        m_memory[real_mem_loc] *= rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = std::move(lhs_opt.value());
+        frame[dest] *= rhs_opt.value();
     }
 
-    void Engine::handle_div(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_div(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
         if (auto temp = lhs_opt.value() / rhs_opt.value(); !temp.is_none()) {
-            const auto real_mem_loc = m_rbp + dest;
-
-            m_memory[real_mem_loc] = std::move(temp);
-            m_rft = std::max(m_rft, real_mem_loc);
-            ++m_rip;
+            frame[dest] = std::move(temp);
         } else {
             m_res = static_cast<int>(Utils::ExecStatus::math_error);
         }
     }
 
-    void Engine::handle_mod(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_mod(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
         if (auto temp = lhs_opt.value() % rhs_opt.value(); !temp.is_none()) {
-            const auto real_mem_loc = m_rbp + dest;
-
-            m_memory[real_mem_loc] = std::move(temp);
-            m_rft = std::max(m_rft, real_mem_loc);
-            ++m_rip;
+            frame[dest] = std::move(temp);
         } else {
             m_res = static_cast<int>(Utils::ExecStatus::math_error);
         }
     }
 
-    void Engine::handle_add(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_add(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
-
-        const auto real_mem_loc = m_rbp + dest;
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        m_memory[real_mem_loc] = std::move(lhs_opt.value());
-        m_memory[real_mem_loc] += rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = std::move(lhs_opt.value());
+        frame[dest] += rhs_opt.value();
     }
 
-    void Engine::handle_sub(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) {
+    void Engine::handle_sub(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        const auto real_mem_loc = m_rbp + dest;
-
-        m_memory[real_mem_loc] = lhs_opt.value();
-        m_memory[real_mem_loc] -= rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = lhs_opt.value();
+        frame[dest] -= rhs_opt.value();
     }
 
-    void Engine::handle_cmp_eq(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_cmp_eq(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
 
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
-
-        const auto real_mem_loc = m_rbp + dest;
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        m_memory[real_mem_loc] = lhs_opt.value() == rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = lhs_opt.value() == rhs_opt.value();
     }
 
-    void Engine::handle_cmp_ne(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_cmp_ne(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
 
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
-
-        const auto real_mem_loc = m_rbp + dest;
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        m_memory[real_mem_loc] = lhs_opt.value() != rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = lhs_opt.value() != rhs_opt.value();
     }
 
-    void Engine::handle_cmp_lt(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_cmp_lt(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
 
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        const auto real_mem_loc = m_rbp + dest;
-
-        m_memory[real_mem_loc] = lhs_opt.value() < rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = lhs_opt.value() < rhs_opt.value();
     }
 
-    void Engine::handle_cmp_gt(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_cmp_gt(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
 
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
-
-        const auto real_mem_loc = m_rbp + dest;
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        m_memory[real_mem_loc] = lhs_opt.value() > rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = lhs_opt.value() > rhs_opt.value();
     }
 
-    void Engine::handle_cmp_gte(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_cmp_gte(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
 
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        const auto real_mem_loc = m_rbp + dest;
-
-        m_memory[real_mem_loc] = lhs_opt.value() >= rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = lhs_opt.value() >= rhs_opt.value();
     }
 
-    void Engine::handle_cmp_lte(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
+    void Engine::handle_cmp_lte(FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept {
         const auto lhs_mode = static_cast<Code::ArgMode>((metadata & 0b00001111000000) >> 6);
         const auto rhs_mode = static_cast<Code::ArgMode>((metadata & 0b11110000000000) >> 10);
 
-        auto lhs_opt = fetch_value(lhs_mode, lhs);
-        auto rhs_opt = fetch_value(rhs_mode, rhs);
-
-        const auto real_mem_loc = m_rbp + dest;
+        auto lhs_opt = fetch_value(frame, lhs_mode, lhs);
+        auto rhs_opt = fetch_value(frame, rhs_mode, rhs);
 
-        m_memory[real_mem_loc] = lhs_opt.value() <= rhs_opt.value();
-        m_rft = std::max(m_rft, real_mem_loc);
-        ++m_rip;
+        frame[dest] = lhs_opt.value() <= rhs_opt.value();
     }
 
-    void Engine::handle_jmp_if(int16_t check_reg, int16_t dest_ip) noexcept {
-        if (m_memory[m_rbp + check_reg]) {
-            m_rip = dest_ip;
-        } else {
-            ++m_rip;
+    /**
+     * @brief Grows the running task's register file at least up to `top_reg`, at least doubling it each time to keep growth amortized. Register frames must stay contiguous since a callee's frame overlaps its caller's argument registers, so the whole file moves & any cached frame pointers must be reloaded afterwards.
+     *
+     * @param top_reg absolute memory index which must fit
+     * @return `false` if that would exceed the register limit.
+     */
+    auto Engine::fit_registers(int top_reg) -> bool {
+        const auto reg_count = static_cast<int>(m_memory.size());
+
+        if (top_reg < reg_count) {
+            return true;
+        } else if (top_reg >= m_reg_limit) {
+            return false;
         }
+
+        m_memory.resize(std::min(std::max(reg_count * 2, top_reg + 1), m_reg_limit));
+
+        return true;
     }
 
-    void Engine::handle_jmp_else(int16_t check_reg, int16_t dest_ip) noexcept {
-        if (!m_memory[m_rbp + check_reg]) {
-            m_rip = dest_ip;
-        } else {
-            ++m_rip;
+    /**
+     * @brief Grows the running task's call stack if it has no room for one more call frame, keeping `m_call_frame_ptr` on the same frame.
+     * @return `false` if the call nesting limit is reached.
+     */
+    auto Engine::fit_call_frame() -> bool {
+        const auto frame_top = static_cast<int>(m_call_frame_ptr - m_call_frames.data());
+        const auto frame_count = static_cast<int>(m_call_frames.size());
+
+        if (frame_top + 1 < frame_count) {
+            return true;
+        } else if (frame_top + 1 >= m_call_frame_limit) {
+            return false;
         }
+
+        m_call_frames.resize(std::min(frame_count * 2, m_call_frame_limit));
+        m_call_frame_ptr = m_call_frames.data() + frame_top;
+
+        return true;
+    }
+
+    /**
+     * @brief Gives the top of the callee's register frame from its recorded layout, where the frame begins at the first argument register.
+     *
+     * @param func_id
+     * @param frame_base absolute memory index of the callee's `RBP`
+     * @return The callee's `RFT`, which may be past the register file until it is grown.
+     */
+    auto Engine::frame_top_of(int16_t func_id, int frame_base) const noexcept -> int {
+        return frame_base + std::max<int>(m_frame_view[func_id].temp_count, 1) - 1;
     }
 
     /**
      * @brief Executes logic for a bytecode function call. Specified operations in `vm.md` under the `call` note are done. Only special registers of RES and RFV are preserved since the call frames already track special register-related values. The stack will pop-off properly where only those 2 special regs mentioned earlier are saved.
      *
-     * @param metadata
      * @param func_id
      * @param arg_count
+     * @param arg_base caller register of the 1st argument
      */
-    void Engine::handle_call(int16_t func_id, int16_t arg_count) noexcept {
+    void Engine::handle_call(int16_t func_id, [[maybe_unused]] int16_t arg_count, int16_t arg_base) {
+        const auto callee_rbp = m_rbp + arg_base;
+        const auto callee_rft = frame_top_of(func_id, callee_rbp);
+        const auto call_frames_full = m_call_frame_ptr + 1 == m_call_frames.data() + m_call_frames.size();
+
+        /// NOTE: Growing either stack is rare, so only the bounds checks stay on the common path.
+        if ((callee_rft >= static_cast<int>(m_memory.size()) && !fit_registers(callee_rft)) || (call_frames_full && !fit_call_frame())) {
+            m_res = static_cast<int>(Utils::ExecStatus::stack_overflow);
+            return;
+        }
+
         const auto old_rfi = m_rfi;
         const int16_t old_rip = m_rip + 1;
         const auto old_rbp = m_rbp;
@@ -581,21 +1680,103 @@ namespace Minuet::Runtime::VM {
         };
         ++m_rrd;
 
+        count_call(func_id);
         m_rfi = func_id;
         m_rip = 0;
-        m_rbp = m_rft - arg_count + 1;
+        m_rbp = callee_rbp;
+        m_rft = callee_rft;
+        m_reg_high_water = std::max(m_reg_high_water, callee_rft);
+
+        if (m_heap.gc_phase() != GCPhase::idle) {
+            try_mark_and_sweep();
+        }
     }
 
-    void Engine::handle_native_call(int16_t native_id, int16_t arg_count) noexcept {
+    /**
+     * @brief Executes a call in tail position by reusing the current register frame and call frame: the arguments slide down to `RBP` and the callee will return straight to the current caller. The recursion depth stays the same.
+     *
+     * @param func_id
+     * @param arg_count
+     * @param arg_base caller register of the 1st argument
+     */
+    void Engine::handle_tail_call(int16_t func_id, int16_t arg_count, int16_t arg_base) {
+        const auto callee_rft = frame_top_of(func_id, m_rbp);
+
+        if (callee_rft >= static_cast<int>(m_memory.size()) && !fit_registers(callee_rft)) {
+            m_res = static_cast<int>(Utils::ExecStatus::stack_overflow);
+            return;
+        }
+
+        const auto args_begin = m_memory.begin() + (m_rbp + arg_base);
+
+        std::copy(args_begin, args_begin + arg_count, m_memory.begin() + m_rbp);
+
+        count_call(func_id);
+        m_rfi = func_id;
+        m_rip = 0;
+        m_rft = callee_rft;
+        m_reg_high_water = std::max(m_reg_high_water, callee_rft);
+
+        /// NOTE: A tail-recursive loop may never allocate, so it steps a collection in progress like any call.
+        if (m_heap.gc_phase() != GCPhase::idle) {
+            try_mark_and_sweep();
+        }
+    }
+
+    void Engine::handle_native_call(int16_t native_id, int16_t arg_count, int16_t arg_base) noexcept {
+        m_native_base = m_rbp + arg_base;
         m_res = (m_native_funcs->data()[native_id](*this, arg_count)) ? ok_res_value : static_cast<int>(Utils::ExecStatus::op_error);
 
-        ++m_rip;
+        if (m_res == ok_res_value) {
+            poll_growth_safepoint();
+        }
+    }
+
+    /**
+     * @brief Starts a bytecode function call as a new green thread, which runs after the already ready tasks. The arguments are copied into the new task's own register window, where its frame begins at cell `0` like the outermost call's.
+     *
+     * @param func_id
+     * @param arg_count
+     * @param arg_base caller register of the 1st argument
+     */
+    void Engine::handle_spawn(int16_t func_id, int16_t arg_count, int16_t arg_base) {
+        Task task = m_tasks.make_task();
+        const auto task_rft = std::max<int>(m_frame_view[func_id].temp_count, 1) - 1;
+
+        if (task_rft >= m_reg_limit) {
+            m_tasks.recycle(std::move(task));
+            m_res = static_cast<int>(Utils::ExecStatus::stack_overflow);
+            return;
+        } else if (task_rft >= static_cast<int>(task.memory.size())) {
+            task.memory.resize(task_rft + 1);
+        }
+
+        const auto args_begin = m_memory.begin() + (m_rbp + arg_base);
+
+        std::copy(args_begin, args_begin + arg_count, task.memory.begin());
+
+        task.call_frames[0] = Utils::CallFrame {
+            .old_func_idx = 0,
+            .old_func_ip = 0,
+            .old_base_ptr = 0,
+            .old_mem_top = 0,
+            .old_exec_status = ok_res_value,
+        };
+        task.call_frame_top = 0;
+        task.rfi = func_id;
+        task.rip = 0;
+        task.rbp = 0;
+        task.rft = task_rft;
+        task.reg_high_water = task_rft;
+        task.rrd = 1;
+
+        m_tasks.push_ready(std::move(task));
     }
 
     void Engine::handle_ret(uint16_t metadata, int16_t src_id) noexcept {
         /// 1. Prepare return value in correct slot for caller to hold correctness.
         const auto src_mode = static_cast<Code::ArgMode>((metadata & 0b00000000111100) >> 2);
-        auto ret_src_opt = fetch_value(src_mode, src_id);
+        auto ret_src_opt = fetch_value(m_memory.data() + m_rbp, src_mode, src_id);
 
         m_memory[m_rbp] = std::move(ret_src_opt.value());
 
@@ -610,6 +1791,7 @@ namespace Minuet::Runtime::VM {
         m_rft = caller_rft;
         m_res = caller_res;
 
-        try_mark_and_sweep();
+        /// NOTE: A callee's frame may end below its caller's, so a collection during the call can lower the high-water mark under registers which the caller writes again from here.
+        m_reg_high_water = std::max(m_reg_high_water, m_rft);
     }
 }
@@ -2,30 +2,63 @@
 #define MINUET_RUNTIME_MINUET_VM
 
 #include <any>
+#include <array>
 #include <cstdint>
+#include <iosfwd>
 #include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "runtime/fast_value.hpp"
 #include "runtime/heap_storage.hpp"
 #include "runtime/bytecode.hpp"
 #include "runtime/natives.hpp"
+#include "runtime/task_scheduler.hpp"
+#include "runtime/jit_x64.hpp"
+#include "runtime/trace_tier.hpp"
 
 namespace Minuet::Runtime::VM {
     namespace Utils {
+        /// NOTE: Where an engine keeps the type feedback for specializing `add, sub, mul, lt` sites to int32 forms.
+        enum class FeedbackMode : uint8_t {
+            off,      // no profiling or specialization
+            shared,   // specializes the program's own chunks, so other engines on it see the same feedback
+            isolated, // specializes an engine-private copy of the chunks
+        };
+
         struct EngineConfig {
-            int reg_buffer_limit;
-            int16_t call_frame_max;
+            int reg_buffer_limit; // most registers which the register file may grow to
+            int call_frame_max;   // deepest call nesting before a run fails with `stack_overflow`
+            bool quicken_code; // rewrites the program into operand-specialized opcodes before running
+            FeedbackMode type_feedback;
+            int slice_budget; // approximate instructions per `operator()` run before it suspends, or `0` for no limit
+            int task_quantum; // approximate instructions a green thread runs before the next ready one gets switched in, or `0` to switch only at `yield`
+            int jit_threshold; // calls of a function before it is compiled to x86-64 code, or `0` to only interpret
+            int trace_threshold; // backward jumps to a loop header before one iteration of it is recorded into a trace, or `0` to never trace
+            int gc_max_pause; // microseconds one step of a full collection may take before the mutator resumes, or `0` to stop the world for each collection
+            int gc_growth_percent; // size of the old generation that starts the next full collection, as a percentage of the bytes which survived the last one, or `0` for 200
+            int gc_threads; // threads which share the stop-the-world marking & sweeping of a large heap, where `0` or `1` uses only the engine's own
         };
 
-        struct CallFrame {
-            int16_t old_func_idx;
-            int16_t old_func_ip;
-            int old_base_ptr;
-            int old_mem_top; // old register frame top
-            uint8_t old_exec_status;
+        /// NOTE: Distribution of an engine's GC pauses, both full collection steps & minor collections. Bucket `i` counts the pauses shorter than `2^i` microseconds but not shorter than half that.
+        struct GCPauseStats {
+            static constexpr auto bucket_count = 24;
+
+            std::array<int64_t, bucket_count> buckets;
+            int64_t count;
+            int64_t total_ns;
+            int64_t max_ns;
+            int64_t full_steps; // pauses which were steps of full collections, the rest of `count` being minor collections
+            int64_t full_step_max_ns;
+            int64_t full_collections; // full collections which finished sweeping
+            int64_t parallel_steps; // full collection steps which shared marking or sweeping among GC threads
         };
 
+        /// NOTE: Receives a census of the heap after each full collection, along with the context given at registration.
+        using gc_observer_t = void (*)(const Runtime::HeapCensus& census, void* context);
+
         enum class ExecStatus : uint8_t {
             ok = 0,
             setup_error,  // invalid setup
@@ -35,74 +68,172 @@ namespace Minuet::Runtime::VM {
             math_error,
             user_error,   // user-caused failure (return nonzero)
             any_error,    // general error
+            suspended,    // slice budget ran out, so calling the engine again resumes the run
+            stack_overflow, // a call or spawn needed more registers or call frames than the configured limits
+        };
+
+        /// NOTE: Outcome of `Engine::invoke()`, where `value` is only set when `status` is `ok`.
+        struct InvokeResult {
+            Runtime::FastValue value;
+            ExecStatus status;
         };
     }
 
     class Engine {
+    private:
+        /// NOTE: starting sizes of the register file & call stack, which grow on demand up to the `EngineConfig` limits
+        static constexpr auto cm_initial_reg_count = 256;
+        static constexpr auto cm_initial_call_frame_count = 64;
+
+        /// NOTE: gray objects traced & old slots swept between clock checks of an incremental GC step
+        static constexpr auto cm_gc_trace_unit = 64UL;
+        static constexpr auto cm_gc_sweep_unit = 256UL;
+
     public:
         Engine(Utils::EngineConfig config, Code::Program& prgm, std::any native_fn_table);
 
         [[nodiscard]] auto operator()() -> Utils::ExecStatus;
 
+        /// NOTE: Embedding API for calling a Minuet function from C++ many times on one warm engine.
+        [[nodiscard]] auto find_function(const std::string& name) const noexcept -> std::optional<int16_t>;
+        [[nodiscard]] auto invoke(int16_t func_id, std::span<const Runtime::FastValue> args) -> Utils::InvokeResult;
+        [[nodiscard]] auto invoke(const std::string& name, std::span<const Runtime::FastValue> args) -> Utils::InvokeResult;
+        [[nodiscard]] auto resume() -> Utils::InvokeResult;
+
         [[nodiscard]] auto handle_native_fn_access(int16_t arg_count, int16_t offset) & noexcept -> Runtime::FastValue&;
 
         void handle_native_fn_return(Runtime::FastValue&& result, [[maybe_unused]] int16_t arg_count) noexcept;
 
+        /// NOTE: Natives call this before storing `item` into the sequence `target`, as the write barriers of incremental & minor collections.
+        void handle_native_fn_store(Runtime::HeapValueBase& target, const Runtime::FastValue& item) noexcept;
+
+        /// NOTE: Natives push `item` onto the sequence `target` through this, which runs the write barriers and counts any growth of the item buffer toward the GC. A collection which that growth calls for runs once the native returns, so that objects the native still points to stay put. Fails for a non-sequence or frozen `target`.
+        [[nodiscard]] auto handle_native_fn_push(Runtime::HeapValueBase& target, const Runtime::FastValue& item) noexcept -> bool;
+
+        [[nodiscard]] auto gc_pause_stats() const noexcept -> const Utils::GCPauseStats&;
+
+        /// NOTE: Allocator counters of the heap's old object slabs & sequence payloads.
+        [[nodiscard]] auto object_slab_stats() const noexcept -> Runtime::AllocatorStats;
+        [[nodiscard]] auto payload_pool_stats() const noexcept -> Runtime::AllocatorStats;
+
+        /// NOTE: Heap analysis API: a census of the resident objects listing up to `largest_count` sequences by payload, and a snapshot of the object graph whose roots are the live registers of every task.
+        [[nodiscard]] auto heap_census(std::size_t largest_count) -> Runtime::HeapCensus;
+        [[nodiscard]] auto write_heap_snapshot(std::ostream& out) -> bool;
+
+        /// NOTE: Calls `observer` with a census after each full collection, or stops doing so for a null `observer`.
+        void set_gc_observer(Utils::gc_observer_t observer, void* context, std::size_t largest_count) noexcept;
+
     private:
-        [[nodiscard]] auto fetch_value(Code::ArgMode mode, int16_t id) noexcept -> std::optional<Runtime::FastValue>;
-
-        void try_mark_and_sweep();
-
-        void handle_make_seq(int16_t dest_reg) noexcept;
-        void handle_seq_obj_push(uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept;
-        void handle_seq_obj_pop(uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept;
-        void handle_seq_obj_get(uint16_t metadata, int16_t dest, int16_t src_id, int16_t pos_value_id) noexcept;
-        void handle_frz_seq_obj(int16_t dest) noexcept;
-
-        void handle_load_const(uint16_t metadata, int16_t dest, int16_t const_id) noexcept;
-        void handle_mov(uint16_t metadata, int16_t dest, int16_t src) noexcept;
-
-        void handle_neg(uint16_t metadata, int16_t dest) noexcept;
-        void handle_inc(uint16_t metadata, int16_t dest) noexcept;
-        void handle_dec(uint16_t metadata, int16_t dest) noexcept;
-        void handle_mul(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_div(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_mod(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_add(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_sub(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs);
-
-        void handle_cmp_eq(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_cmp_ne(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_cmp_lt(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_cmp_gt(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_cmp_gte(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-        void handle_cmp_lte(uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
-
-        // void handle_jmp(int16_t dest_ip) noexcept;
-        void handle_jmp_if(int16_t check_reg, int16_t dest_ip) noexcept;
-        void handle_jmp_else(int16_t check_reg, int16_t dest_ip) noexcept;
-        void handle_call(int16_t func_id, int16_t arg_count) noexcept;
-        void handle_native_call(int16_t native_id, [[maybe_unused]] int16_t arg_count) noexcept;
+        [[nodiscard]] auto dispatch() -> Utils::ExecStatus;
+        void enter_function(int16_t func_id) noexcept;
+
+        void swap_task(Task& task) noexcept;
+        void switch_task();
+        void finish_task();
+        void restore_home_task();
+
+        void count_call(int16_t func_id) noexcept;
+        [[nodiscard]] auto prepare_jit(int16_t func_id) -> JIT::JitEntry;
+        [[nodiscard]] auto record_trace(Runtime::FastValue* frame, int header_ip) -> int;
+        [[nodiscard]] static auto step_instruction(void* engine_p, Runtime::FastValue* frame, const Code::Instruction* inst) noexcept -> bool;
+
+        [[nodiscard]] auto fetch_value(const Runtime::FastValue* frame, Code::ArgMode mode, int16_t id) noexcept -> std::optional<Runtime::FastValue>;
+
+        void try_mark_and_sweep() noexcept;
+        void mark_roots() noexcept;
+        void mark_registers(Runtime::FastValue* registers, int top_reg) noexcept;
+        void clear_all_dead_registers() noexcept;
+        void record_gc_pause(int64_t pause_ns, bool full_step) noexcept;
+        void collect_young();
+        [[nodiscard]] auto push_counted(Runtime::HeapValueBase& target, Runtime::FastValue item) noexcept -> bool;
+        void poll_growth_safepoint() noexcept;
+        void forward_registers(Runtime::FastValue* registers, int top_reg);
+        void clear_dead_registers(Runtime::FastValue* registers, int top_reg, int& high_water) noexcept;
+
+        void handle_make_seq(Runtime::FastValue* frame, int16_t dest_reg) noexcept;
+        void handle_seq_obj_push(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept;
+        void handle_seq_obj_pop(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t src_id, int16_t mode) noexcept;
+        void handle_seq_obj_get(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t src_id, int16_t pos_value_id) noexcept;
+        void handle_frz_seq_obj(Runtime::FastValue* frame, int16_t dest) noexcept;
+        void handle_seq_len(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t src_id) noexcept;
+
+        void handle_load_const(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t const_id) noexcept;
+        void handle_mov(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t src) noexcept;
+
+        void handle_neg(Runtime::FastValue* frame, uint16_t metadata, int16_t dest) noexcept;
+        void handle_inc(Runtime::FastValue* frame, uint16_t metadata, int16_t dest) noexcept;
+        void handle_dec(Runtime::FastValue* frame, uint16_t metadata, int16_t dest) noexcept;
+        void handle_mul(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_div(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_mod(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_add(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_sub(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs);
+
+        void handle_cmp_eq(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_cmp_ne(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_cmp_lt(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_cmp_gt(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_cmp_gte(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+        void handle_cmp_lte(Runtime::FastValue* frame, uint16_t metadata, int16_t dest, int16_t lhs, int16_t rhs) noexcept;
+
+        /// NOTE: Jumps are handled inline by the dispatch loop.
+        [[nodiscard]] auto fit_registers(int top_reg) -> bool;
+        [[nodiscard]] auto fit_call_frame() -> bool;
+        [[nodiscard]] auto frame_top_of(int16_t func_id, int frame_base) const noexcept -> int;
+        void handle_call(int16_t func_id, int16_t arg_count, int16_t arg_base);
+        void handle_tail_call(int16_t func_id, int16_t arg_count, int16_t arg_base);
+        void handle_native_call(int16_t native_id, [[maybe_unused]] int16_t arg_count, int16_t arg_base) noexcept;
+        void handle_spawn(int16_t func_id, int16_t arg_count, int16_t arg_base);
         void handle_ret(uint16_t metadata, int16_t src_id) noexcept;
         // void handle_halt(int16_t metadata, int16_t src_id);
 
         HeapStorage m_heap;
+        TaskScheduler m_tasks;
         std::vector<Runtime::FastValue> m_memory;
         std::vector<Utils::CallFrame> m_call_frames;
-
-        const Code::Chunk* m_chunk_view;
+        std::vector<Code::Chunk> m_own_chunks;
+        std::vector<Code::ChunkFeedback> m_own_feedback;
+        std::vector<JIT::CompiledChunk> m_jit_chunks;
+        std::vector<int> m_call_counts;
+        JIT::JitContext m_jit_ctx;
+        std::vector<std::vector<Trace::HeaderSlot>> m_header_slots;
+        std::vector<Trace::Trace> m_traces;
+        Utils::GCPauseStats m_gc_pauses;
+        Utils::gc_observer_t m_gc_observer;
+        void* m_gc_observer_context;
+        std::size_t m_gc_census_top;
+
+        Code::Chunk* m_chunk_view;
+        Code::ChunkFeedback* m_feedback_view;
         const FastValue* m_const_view;
         Utils::CallFrame* m_call_frame_ptr;
         const Runtime::NativeProcTable* m_native_funcs;
+        const Code::FrameLayout* m_frame_view;
+        const std::unordered_map<std::string, int16_t>* m_function_ids;
 
         int16_t m_rfi;  // Contains the callee ID
         int16_t m_rip;  // Contains the instruction index in the callee's chunk
         int m_rbp;  // Contains the base point of the current register frame in memory
-        int m_rft;  // Contains highest memory cell used
+        int m_rft;  // Contains the top memory cell of the current register frame
+        int m_reg_high_water; // Contains the highest memory cell any frame reached since the last GC
+        int m_native_base; // Contains the 1st argument's memory cell for the running native call
         int m_rsp;
         int m_consts_n;
-        int16_t m_rrd; // Counts 1-based recursion depth- 0 means done!
+        int m_reg_limit;
+        int m_call_frame_limit;
+        int m_slice_budget;
+        int m_task_quantum;
+        int64_t m_quantum_left; // Contains the running task's remaining quantum across suspended runs
+        int m_jit_threshold;
+        int m_trace_threshold;
+        int64_t m_gc_max_pause_ns;
+        std::size_t m_gc_threads;
+        int m_funcs_n;
+        int m_rrd; // Counts 1-based recursion depth- 0 means done!
         uint8_t m_res;  // Contains execution status code
+        bool m_setup_ok;
+        bool m_on_home_task;
+        bool m_payload_grew; // Set by a push which grew an item buffer since the last growth safepoint
     };
 }
 
@@ -378,6 +378,22 @@ namespace Minuet::Semantics {
         return true;
     }
 
+    auto Analyzer::check_spawn(const Syntax::Stmts::Spawn& stmt, const std::string& source) noexcept -> bool {
+        const auto call_p = std::get_if<Syntax::Exprs::Call>(&stmt.call->data);
+
+        if (call_p == nullptr) {
+            report_error("Only function calls can be spawned.", source, stmt.call->src_begin, stmt.call->src_end);
+
+            return false;
+        }
+
+        return check_call(*call_p, source).has_value();
+    }
+
+    auto Analyzer::check_yield([[maybe_unused]] const Syntax::Stmts::Yield& stmt, [[maybe_unused]] const std::string& source) noexcept -> bool {
+        return true;
+    }
+
     auto Analyzer::check_block(const Syntax::Stmts::Block& stmt, const std::string& source) noexcept -> bool {
         for (const auto& item : stmt.items) {
             if (!check_stmt(item, source)) {
@@ -472,6 +488,10 @@ namespace Minuet::Semantics {
             return check_while(*while_stmt_p, source);
         } else if (auto break_stmt_p = std::get_if<Syntax::Stmts::Break>(&stmt_p->data); break_stmt_p) {
             return check_break(*break_stmt_p, source);
+        } else if (auto spawn_stmt_p = std::get_if<Syntax::Stmts::Spawn>(&stmt_p->data); spawn_stmt_p) {
+            return check_spawn(*spawn_stmt_p, source);
+        } else if (auto yield_stmt_p = std::get_if<Syntax::Stmts::Yield>(&stmt_p->data); yield_stmt_p) {
+            return check_yield(*yield_stmt_p, source);
         } else if (auto block_p = std::get_if<Syntax::Stmts::Block>(&stmt_p->data); block_p) {
             return check_block(*block_p, source);
         } else if (auto function_decl_p = std::get_if<Syntax::Stmts::Function>(&stmt_p->data); function_decl_p) {
@@ -83,6 +83,8 @@ namespace Minuet::Semantics {
         [[nodiscard]] auto check_return(const Syntax::Stmts::Return& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_while(const Syntax::Stmts::While& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_break(const Syntax::Stmts::Break& stmt, const std::string& source) noexcept -> bool;
+        [[nodiscard]] auto check_spawn(const Syntax::Stmts::Spawn& stmt, const std::string& source) noexcept -> bool;
+        [[nodiscard]] auto check_yield(const Syntax::Stmts::Yield& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_block(const Syntax::Stmts::Block& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_function(const Syntax::Stmts::Function& stmt, const std::string& source) noexcept -> bool;
         [[nodiscard]] auto check_native_stub(const Syntax::Stmts::NativeStub& stmt, const std::string& source) noexcept -> bool;
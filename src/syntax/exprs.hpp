@@ -18,12 +18,14 @@ namespace Minuet::Syntax::Stmts {
     struct Return;
     struct While;
     struct Break;
+    struct Spawn;
+    struct Yield;
     struct Block;
     struct Function;
     struct NativeStub;
     struct Import;
 
-    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, If, Return, While, Break, Block, Function, NativeStub, Import>>;
+    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, If, Return, While, Break, Spawn, Yield, Block, Function, NativeStub, Import>>;
 }
 
 namespace Minuet::Syntax::Exprs {
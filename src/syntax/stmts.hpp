@@ -17,13 +17,15 @@ namespace Minuet::Syntax::Stmts {
     struct Return;
     struct While;
     struct Break;
+    struct Spawn;
+    struct Yield;
     struct Block;
     struct Function;
     struct NativeStub;
     struct Import;
 
     // using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, Match, MatchCase, Block, Function>>;
-    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, If, Return, While, Break, Block, Function, NativeStub, Import>>;
+    using StmtPtr = std::unique_ptr<StmtNode<ExprStmt, LocalDef, If, Return, While, Break, Spawn, Yield, Block, Function, NativeStub, Import>>;
 
     struct ExprStmt {
         Exprs::ExprPtr expr;
@@ -60,6 +62,14 @@ namespace Minuet::Syntax::Stmts {
 
     struct Break {};
 
+    /// NOTE: Starts a Minuet function call as a new green thread of the same VM.
+    struct Spawn {
+        Exprs::ExprPtr call;
+    };
+
+    /// NOTE: Lets the VM switch to the next ready green thread.
+    struct Yield {};
+
     struct Block {
         std::vector<StmtPtr> items;
     };
@@ -86,7 +96,7 @@ namespace Minuet::Syntax::Stmts {
         uint32_t src_end;
     };
 
-    using Stmt = StmtNode<ExprStmt, LocalDef, If, Return, While, Break, Block, Function, NativeStub, Import>;
+    using Stmt = StmtNode<ExprStmt, LocalDef, If, Return, While, Break, Spawn, Yield, Block, Function, NativeStub, Import>;
 }
 
 #endif
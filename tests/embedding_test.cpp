@@ -0,0 +1,131 @@
+#include <array>
+#include <optional>
+
+#include "test_support.hpp"
+
+using namespace Minuet;
+using Runtime::FastValue;
+using Runtime::FVTag;
+using Runtime::VM::Utils::ExecStatus;
+
+static constexpr std::string_view embedding_program_path = "./tests/programs/embedding.mnl";
+
+[[nodiscard]] static auto int32_of(const FastValue& value) -> std::optional<int> {
+    if (value.tag() != FVTag::int32) {
+        return {};
+    }
+
+    return value.to_int32_unchecked();
+}
+
+static void test_unknown_function(Tests::TestRun& run, Runtime::Code::Program& program, Driver::Driver& driver) {
+    auto vm = driver.make_engine(program);
+
+    run.expect(!vm.find_function("no_such_function").has_value(), "find_function gives nothing for an unknown name");
+    run.expect(vm.invoke("no_such_function", {}).status == ExecStatus::arg_error, "invoking an unknown name is an arg_error");
+    run.expect(vm.invoke(int16_t {-1}, {}).status == ExecStatus::arg_error, "invoking a negative function id is an arg_error");
+}
+
+static void test_bad_arguments(Tests::TestRun& run, Runtime::Code::Program& program, Driver::Driver& driver) {
+    auto vm = driver.make_engine(program);
+    const std::array<FastValue, 1> one_arg {FastValue {1}};
+    const std::array<FastValue, 3> three_args {FastValue {1}, FastValue {2}, FastValue {3}};
+
+    run.expect(vm.invoke("add", one_arg).status == ExecStatus::arg_error, "too few arguments are an arg_error");
+    run.expect(vm.invoke("add", three_args).status == ExecStatus::arg_error, "too many arguments are an arg_error");
+
+    const std::array<FastValue, 1> wrap_args {FastValue {5}};
+    auto wrapped = vm.invoke("wrap", wrap_args);
+
+    if (!run.expect(wrapped.status == ExecStatus::ok && wrapped.value.tag() == FVTag::sequence, "wrap returns a sequence")) {
+        return;
+    }
+
+    const auto& wrapped_items = wrapped.value.to_object_ptr()->items();
+
+    run.expect(wrapped_items.size() == 1UL && int32_of(wrapped_items[0]) == 5, "the returned sequence holds the argument");
+
+    /// NOTE: An object argument would refer to the heap which the next invocation clears.
+    const std::array<FastValue, 2> object_args {wrapped.value, FastValue {1}};
+
+    run.expect(vm.invoke("add", object_args).status == ExecStatus::arg_error, "an object argument is an arg_error");
+
+    const std::array<FastValue, 2> good_args {FastValue {2}, FastValue {3}};
+    auto good_sum = vm.invoke("add", good_args);
+
+    run.expect(good_sum.status == ExecStatus::ok && int32_of(good_sum.value) == 5, "the engine still runs after rejected calls");
+}
+
+static void test_warm_reinvoke(Tests::TestRun& run, Runtime::Code::Program& program, Driver::Driver& driver) {
+    driver.set_jit_threshold(2);
+    driver.set_trace_threshold(2);
+
+    auto vm = driver.make_engine(program);
+    const auto sum_to_id = vm.find_function("sum_to");
+
+    if (!run.expect(sum_to_id.has_value(), "find_function finds sum_to")) {
+        return;
+    }
+
+    auto all_sums_ok = true;
+
+    for (auto n = 0; n < 200; ++n) {
+        const std::array<FastValue, 1> sum_args {FastValue {n}};
+        auto result = vm.invoke(sum_to_id.value(), sum_args);
+
+        all_sums_ok = all_sums_ok && result.status == ExecStatus::ok && int32_of(result.value) == n * (n + 1) / 2;
+    }
+
+    run.expect(all_sums_ok, "repeated invocations of a warmed function give the same results as the first");
+
+    const std::array<FastValue, 2> add_args {FastValue {40}, FastValue {2}};
+    auto add_result = vm.invoke("add", add_args);
+
+    run.expect(add_result.status == ExecStatus::ok && int32_of(add_result.value) == 42, "another function runs on the same warm engine");
+
+    driver.set_jit_threshold(0);
+    driver.set_trace_threshold(0);
+}
+
+static void test_resume_after_suspend(Tests::TestRun& run, Runtime::Code::Program& program, Driver::Driver& driver) {
+    driver.set_slice_budget(64);
+
+    auto vm = driver.make_engine(program);
+    const std::array<FastValue, 1> sum_args {FastValue {10000}};
+    auto result = vm.invoke("sum_to", sum_args);
+    auto resume_count = 0;
+
+    run.expect(result.status == ExecStatus::suspended, "a long call suspends once its slice budget is spent");
+
+    while (result.status == ExecStatus::suspended) {
+        result = vm.resume();
+        ++resume_count;
+    }
+
+    run.expect(resume_count > 1, "the call took several slices");
+    run.expect(result.status == ExecStatus::ok && int32_of(result.value) == 50005000, "resuming finishes the call with its result");
+
+    const std::array<FastValue, 1> short_args {FastValue {3}};
+    auto short_result = vm.invoke("sum_to", short_args);
+
+    run.expect(short_result.status == ExecStatus::ok && int32_of(short_result.value) == 6, "a call within one slice finishes without resuming");
+
+    driver.set_slice_budget(0);
+}
+
+int main() {
+    Tests::TestRun run {"embedding_test"};
+    auto driver = Tests::make_driver();
+    auto program_opt = driver.compile(embedding_program_path);
+
+    if (!run.expect(program_opt.has_value(), "the embedding program compiles")) {
+        return run.finish();
+    }
+
+    test_unknown_function(run, program_opt.value(), driver);
+    test_bad_arguments(run, program_opt.value(), driver);
+    test_warm_reinvoke(run, program_opt.value(), driver);
+    test_resume_after_suspend(run, program_opt.value(), driver);
+
+    return run.finish();
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+
+#include "test_support.hpp"
+
+using namespace Minuet;
+using Runtime::VM::Utils::ExecStatus;
+
+static constexpr std::string_view incremental_program_path = "./test_suite/simple/gc_incremental.mnl";
+static constexpr std::string_view parallel_program_path = "./test_suite/simple/gc_parallel.mnl";
+static constexpr std::string_view loop_alloc_program_path = "./test_suite/simple/gc_loop_alloc.mnl";
+
+/// NOTE: A step stops at its first clock check past the bound, so it may overrun by one unit of tracing or sweeping, and the last marking step re-marks the registers & traces what is left in one go. A loaded machine may also deschedule a step, so a run gets a few tries to stay within the bound plus that slack.
+static constexpr auto incremental_pause_us = 10;
+static constexpr auto incremental_step_slack_us = 250;
+static constexpr auto incremental_step_limit_ns = int64_t {incremental_pause_us + incremental_step_slack_us} * 1000;
+static constexpr auto incremental_attempts = 3;
+
+static void test_incremental_steps(Tests::TestRun& run) {
+    auto driver = Tests::make_driver();
+
+    driver.set_gc_max_pause(incremental_pause_us);
+
+    auto program_opt = driver.compile(incremental_program_path);
+
+    if (!run.expect(program_opt.has_value(), "the incremental GC program compiles")) {
+        return;
+    }
+
+    Runtime::VM::Utils::GCPauseStats best_stats {};
+    auto all_runs_ok = true;
+
+    for (auto attempt = 0; attempt < incremental_attempts; ++attempt) {
+        auto vm = driver.make_engine(program_opt.value());
+
+        all_runs_ok = all_runs_ok && vm() == ExecStatus::ok;
+
+        if (const auto& stats = vm.gc_pause_stats(); attempt == 0 || stats.full_step_max_ns < best_stats.full_step_max_ns) {
+            best_stats = stats;
+        }
+
+        if (best_stats.full_step_max_ns <= incremental_step_limit_ns) {
+            break;
+        }
+    }
+
+    run.expect(all_runs_ok, "every live value survives the incremental collections");
+    run.expect(best_stats.full_collections >= 3, "the program runs several full collections");
+    run.expect(best_stats.full_steps >= 2 * best_stats.full_collections, "full collections take more than one step each");
+    run.expect(best_stats.full_step_max_ns <= incremental_step_limit_ns, "no full collection step overruns its pause bound by more than the slack");
+    run.expect(best_stats.full_steps < best_stats.count, "minor collections count as pauses apart from the full steps");
+}
+
+/// NOTE: gc_parallel.mnl keeps 50 lists of 200 pairs plus the list of lists, more than the 8192 old slots which a collection needs before sharing its work.
+static constexpr auto parallel_kept_count = 50UL * 200UL + 50UL + 1UL;
+static constexpr auto parallel_min_slots = 8192UL;
+static constexpr auto parallel_thread_count = 4;
+
+struct ParallelCensusLog {
+    int collection_count;
+    int kept_collection_count;
+    bool slots_over_threshold;
+};
+
+static void log_parallel_census(const Runtime::HeapCensus& census, void* context) {
+    auto& log = *static_cast<ParallelCensusLog*>(context);
+    const auto sequence_count = census.by_tag[static_cast<std::size_t>(Runtime::ObjectTag::sequence)].object_count;
+
+    ++log.collection_count;
+
+    if (sequence_count >= parallel_kept_count) {
+        ++log.kept_collection_count;
+        log.slots_over_threshold = log.slots_over_threshold && census.slot_high_water >= parallel_min_slots;
+    }
+}
+
+static void test_parallel_collections(Tests::TestRun& run) {
+    auto driver = Tests::make_driver();
+
+    driver.set_gc_threads(parallel_thread_count);
+
+    auto program_opt = driver.compile(parallel_program_path);
+
+    if (!run.expect(program_opt.has_value(), "the parallel GC program compiles")) {
+        return;
+    }
+
+    auto vm = driver.make_engine(program_opt.value());
+    ParallelCensusLog log {
+        .collection_count = 0,
+        .kept_collection_count = 0,
+        .slots_over_threshold = true,
+    };
+
+    vm.set_gc_observer(log_parallel_census, &log, 0UL);
+
+    run.expect(vm() == ExecStatus::ok, "every kept pair survives the parallel collections with its own indices");
+    run.expect(log.kept_collection_count >= 3, "several full collections find every kept sequence alive");
+    run.expect(log.slots_over_threshold, "those collections cover more old slots than the parallel threshold");
+    run.expect(vm.gc_pause_stats().parallel_steps >= 3, "those collections share their marking or sweeping among the GC threads");
+    run.expect(vm.gc_pause_stats().full_collections == log.collection_count, "the observer sees every full collection");
+}
+
+/// NOTE: gc_loop_alloc.mnl allocates 100000 pairs in one loop but keeps at most 10 batches of 250, about 100 KiB of old objects, so only collections at its allocation safepoints keep the old generation this small.
+static constexpr auto loop_alloc_max_old_bytes = 256UL * 1024UL;
+static constexpr auto loop_alloc_max_next_gc_bytes = 2UL * loop_alloc_max_old_bytes;
+
+struct LoopAllocCensusLog {
+    int collection_count;
+    std::size_t max_old_bytes;
+    std::size_t max_next_gc_bytes;
+};
+
+static void log_loop_alloc_census(const Runtime::HeapCensus& census, void* context) {
+    auto& log = *static_cast<LoopAllocCensusLog*>(context);
+
+    ++log.collection_count;
+    log.max_old_bytes = std::max(log.max_old_bytes, census.old_bytes);
+    log.max_next_gc_bytes = std::max(log.max_next_gc_bytes, census.next_gc_bytes);
+}
+
+static void test_loop_alloc_bounded(Tests::TestRun& run) {
+    auto driver = Tests::make_driver();
+    auto program_opt = driver.compile(loop_alloc_program_path);
+
+    if (!run.expect(program_opt.has_value(), "the loop allocation program compiles")) {
+        return;
+    }
+
+    auto vm = driver.make_engine(program_opt.value());
+    LoopAllocCensusLog log {
+        .collection_count = 0,
+        .max_old_bytes = 0UL,
+        .max_next_gc_bytes = 0UL,
+    };
+
+    vm.set_gc_observer(log_loop_alloc_census, &log, 0UL);
+
+    run.expect(vm() == ExecStatus::ok, "every kept batch survives the loop's collections with its own entries");
+    run.expect(log.collection_count >= 10, "the loop runs many full collections without any call or return");
+    run.expect(log.max_old_bytes <= loop_alloc_max_old_bytes, "the old generation after each collection stays near the kept batches");
+    run.expect(log.max_next_gc_bytes <= loop_alloc_max_next_gc_bytes, "the next collection always starts before the old generation grows far past the kept batches");
+}
+
+int main() {
+    Tests::TestRun run {"gc_test"};
+
+    test_incremental_steps(run);
+    test_parallel_collections(run);
+    test_loop_alloc_bounded(run);
+
+    return run.finish();
+}
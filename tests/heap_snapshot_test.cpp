@@ -0,0 +1,268 @@
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "runtime/heap_census.hpp"
+#include "test_support.hpp"
+
+using namespace Minuet;
+using Runtime::VM::Utils::ExecStatus;
+
+static constexpr std::string_view snapshot_program_path = "./tests/programs/heap_snapshot.mnl";
+
+/// NOTE: Small enough that main suspends many times while it spins with its rows alive.
+static constexpr auto snapshot_slice_budget = 5000;
+static constexpr auto snapshot_row_count = 21UL;
+
+struct SnapshotObject {
+    uint64_t id;
+    uint8_t tag;
+    uint8_t flags;
+    uint32_t element_count;
+    uint64_t memory_score;
+    std::vector<uint64_t> child_ids;
+};
+
+struct SnapshotGraph {
+    uint64_t object_count;
+    std::vector<uint64_t> root_ids;
+    std::vector<SnapshotObject> objects;
+};
+
+template <typename Field>
+[[nodiscard]] static auto read_field(std::istream& in) -> std::optional<Field> {
+    Field field {};
+
+    if (!in.read(reinterpret_cast<char*>(&field), sizeof(Field))) {
+        return {};
+    }
+
+    return field;
+}
+
+/// NOTE: Reads a snapshot back in the layout of `runtime/heap_census.hpp`, giving nothing for a bad magic, nonzero padding, a short read, or trailing bytes.
+[[nodiscard]] static auto read_snapshot(std::istream& in) -> std::optional<SnapshotGraph> {
+    std::string magic(Runtime::Snapshot::magic.size(), '\0');
+
+    if (!in.read(magic.data(), static_cast<std::streamsize>(magic.size())) || magic != Runtime::Snapshot::magic) {
+        return {};
+    }
+
+    const auto object_count_opt = read_field<uint64_t>(in);
+    const auto root_count_opt = read_field<uint64_t>(in);
+
+    if (!object_count_opt || !root_count_opt) {
+        return {};
+    }
+
+    SnapshotGraph graph {
+        .object_count = object_count_opt.value(),
+        .root_ids = {},
+        .objects = {},
+    };
+
+    for (auto root_index = 0UL; root_index < root_count_opt.value(); ++root_index) {
+        const auto root_id_opt = read_field<uint64_t>(in);
+
+        if (!root_id_opt) {
+            return {};
+        }
+
+        graph.root_ids.emplace_back(root_id_opt.value());
+    }
+
+    for (auto object_index = 0UL; object_index < graph.object_count; ++object_index) {
+        const auto id_opt = read_field<uint64_t>(in);
+        const auto tag_opt = read_field<uint8_t>(in);
+        const auto flags_opt = read_field<uint8_t>(in);
+        const auto pad_16_opt = read_field<uint16_t>(in);
+        const auto element_count_opt = read_field<uint32_t>(in);
+        const auto memory_score_opt = read_field<uint64_t>(in);
+        const auto ref_count_opt = read_field<uint32_t>(in);
+        const auto pad_32_opt = read_field<uint32_t>(in);
+
+        /// NOTE: A short read fails the stream, so every later field is empty too.
+        if (!pad_32_opt || pad_16_opt.value() != 0 || pad_32_opt.value() != 0) {
+            return {};
+        }
+
+        SnapshotObject object {
+            .id = id_opt.value(),
+            .tag = tag_opt.value(),
+            .flags = flags_opt.value(),
+            .element_count = element_count_opt.value(),
+            .memory_score = memory_score_opt.value(),
+            .child_ids = {},
+        };
+
+        for (auto ref_index = 0U; ref_index < ref_count_opt.value(); ++ref_index) {
+            const auto child_id_opt = read_field<uint64_t>(in);
+
+            if (!child_id_opt) {
+                return {};
+            }
+
+            object.child_ids.emplace_back(child_id_opt.value());
+        }
+
+        graph.objects.emplace_back(std::move(object));
+    }
+
+    if (in.peek() != std::char_traits<char>::eof()) {
+        return {};
+    }
+
+    return graph;
+}
+
+/// NOTE: Checks of every snapshot taken during the run, so that one failing snapshot among many fails its check once.
+struct SnapshotChecks {
+    bool all_read;
+    bool counts_match_census;
+    bool ids_unique;
+    bool young_flags_match_ids;
+    bool roots_resolve;
+    bool children_resolve;
+    int snapshot_count;
+};
+
+static void check_snapshot(SnapshotChecks& checks, const SnapshotGraph& graph, const Runtime::HeapCensus& census) {
+    std::size_t census_object_count = 0;
+
+    for (const auto& tag_census : census.by_tag) {
+        census_object_count += tag_census.object_count;
+    }
+
+    checks.counts_match_census = checks.counts_match_census && graph.object_count == census_object_count && graph.objects.size() == census_object_count;
+
+    std::unordered_map<uint64_t, const SnapshotObject*> objects_by_id;
+
+    for (const auto& object : graph.objects) {
+        checks.ids_unique = checks.ids_unique && objects_by_id.emplace(object.id, &object).second;
+
+        const auto young = (object.flags & static_cast<uint8_t>(Runtime::Snapshot::ObjectFlag::young)) != 0;
+
+        checks.young_flags_match_ids = checks.young_flags_match_ids && young == (object.id >= census.slot_high_water);
+    }
+
+    checks.roots_resolve = checks.roots_resolve && !graph.root_ids.empty();
+
+    for (const auto root_id : graph.root_ids) {
+        checks.roots_resolve = checks.roots_resolve && objects_by_id.contains(root_id);
+    }
+
+    for (const auto& object : graph.objects) {
+        for (const auto child_id : object.child_ids) {
+            checks.children_resolve = checks.children_resolve && objects_by_id.contains(child_id);
+        }
+    }
+
+    ++checks.snapshot_count;
+}
+
+/// NOTE: Finds main's rows among the roots of a snapshot taken while it spins, then checks each row & the row pairs down to their leaves.
+static void check_rows(Tests::TestRun& run, const SnapshotGraph& graph) {
+    std::unordered_map<uint64_t, const SnapshotObject*> objects_by_id;
+
+    for (const auto& object : graph.objects) {
+        objects_by_id.emplace(object.id, &object);
+    }
+
+    const SnapshotObject* rows_p = nullptr;
+
+    for (const auto root_id : graph.root_ids) {
+        if (const auto* root_p = objects_by_id[root_id]; root_p->child_ids.size() == snapshot_row_count) {
+            rows_p = root_p;
+        }
+    }
+
+    if (!run.expect(rows_p != nullptr, "a root holds all of main's rows")) {
+        return;
+    }
+
+    run.expect(rows_p->tag == static_cast<uint8_t>(Runtime::ObjectTag::sequence) && rows_p->element_count == snapshot_row_count && rows_p->memory_score > 0, "the rows sequence records its tag, element count & payload");
+
+    auto rows_ok = true;
+    auto young_rows_ok = true;
+
+    for (auto row_index = 0UL; row_index < snapshot_row_count; ++row_index) {
+        const auto* row_p = objects_by_id[rows_p->child_ids[row_index]];
+
+        if (row_p->child_ids.size() != 2UL || row_p->element_count != 2U) {
+            rows_ok = false;
+            continue;
+        }
+
+        const auto* single_p = objects_by_id[row_p->child_ids[0]];
+        const auto* pair_p = objects_by_id[row_p->child_ids[1]];
+
+        rows_ok = rows_ok && single_p->element_count == 1U && single_p->child_ids.empty() && pair_p->element_count == 2U && pair_p->child_ids.empty();
+
+        const auto young = (row_p->flags & static_cast<uint8_t>(Runtime::Snapshot::ObjectFlag::young)) != 0;
+
+        young_rows_ok = young_rows_ok && young == (row_index + 1UL == snapshot_row_count);
+    }
+
+    run.expect(rows_ok, "each row refers to its two leaf sequences in item order");
+    run.expect(young_rows_ok, "only the last row, pushed after the promotions, is young");
+}
+
+int main() {
+    Tests::TestRun run {"heap_snapshot_test"};
+    auto driver = Tests::make_driver();
+
+    driver.set_slice_budget(snapshot_slice_budget);
+
+    auto program_opt = driver.compile(snapshot_program_path);
+
+    if (!run.expect(program_opt.has_value(), "the heap snapshot program compiles")) {
+        return run.finish();
+    }
+
+    auto vm = driver.make_engine(program_opt.value());
+    SnapshotChecks checks {
+        .all_read = true,
+        .counts_match_census = true,
+        .ids_unique = true,
+        .young_flags_match_ids = true,
+        .roots_resolve = true,
+        .children_resolve = true,
+        .snapshot_count = 0,
+    };
+    std::optional<SnapshotGraph> last_graph_opt;
+    auto status = vm();
+
+    while (status == ExecStatus::suspended) {
+        std::stringstream snapshot_stream;
+
+        checks.all_read = checks.all_read && vm.write_heap_snapshot(snapshot_stream);
+
+        if (auto graph_opt = read_snapshot(snapshot_stream); graph_opt) {
+            check_snapshot(checks, graph_opt.value(), vm.heap_census(0UL));
+            last_graph_opt = std::move(graph_opt);
+        } else {
+            checks.all_read = false;
+        }
+
+        status = vm();
+    }
+
+    run.expect(status == ExecStatus::ok, "the program finishes after its suspensions");
+    run.expect(checks.snapshot_count > 1, "the program suspends several times");
+    run.expect(checks.all_read, "every snapshot reads back with its magic, counts & records");
+    run.expect(checks.counts_match_census, "every snapshot holds as many objects as the census counts");
+    run.expect(checks.ids_unique, "object ids are unique within a snapshot");
+    run.expect(checks.young_flags_match_ids, "young objects & only they have ids past the old slots");
+    run.expect(checks.roots_resolve, "every snapshot has roots, which all resolve to emitted objects");
+    run.expect(checks.children_resolve, "every reference resolves to an emitted object");
+
+    if (last_graph_opt) {
+        check_rows(run, last_graph_opt.value());
+    }
+
+    return run.finish();
+}
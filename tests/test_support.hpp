@@ -0,0 +1,64 @@
+#ifndef MINUET_TESTS_TEST_SUPPORT_HPP
+#define MINUET_TESTS_TEST_SUPPORT_HPP
+
+#include <iostream>
+#include <print>
+#include <source_location>
+#include <string_view>
+
+#include "mintrinsics/mnl_stdio.hpp"
+#include "mintrinsics/mnl_lists.hpp"
+#include "driver/driver.hpp"
+
+namespace Minuet::Tests {
+    /**
+     * @brief Counts the failed checks of one test program, which keeps going after a failure so that one run reports all of them.
+     */
+    class TestRun {
+    private:
+        std::string_view m_name;
+        int m_check_count;
+        int m_failure_count;
+
+    public:
+        explicit TestRun(std::string_view name) noexcept
+        : m_name {name}, m_check_count {0}, m_failure_count {0} {}
+
+        auto expect(bool condition, std::string_view what, std::source_location where = std::source_location::current()) -> bool {
+            ++m_check_count;
+
+            if (!condition) {
+                ++m_failure_count;
+                std::println(std::cerr, "\033[1;31mFAILED {}:{}: {}\033[0m", where.file_name(), where.line(), what);
+            }
+
+            return condition;
+        }
+
+        /// NOTE: Gives the exit code for CTest.
+        [[nodiscard]] auto finish() const -> int {
+            std::println("{}: {} of {} checks passed", m_name, m_check_count - m_failure_count, m_check_count);
+
+            return (m_failure_count == 0) ? 0 : 1;
+        }
+    };
+
+    /// NOTE: Gives a driver with the same natives as `minuetm`. Engines which it makes refer to its native table, so it must outlive them.
+    [[nodiscard]] inline auto make_driver() -> Driver::Driver {
+        Driver::Driver driver;
+
+        driver.register_native_proc({"print", Intrinsics::native_print_value});
+        driver.register_native_proc({"prompt_int", Intrinsics::native_prompt_int});
+        driver.register_native_proc({"prompt_float", Intrinsics::native_prompt_float});
+
+        driver.register_native_proc({"len_of", Intrinsics::native_len_of, true});
+        driver.register_native_proc({"list_push_back", Intrinsics::native_list_push_back, true});
+        driver.register_native_proc({"list_pop_back", Intrinsics::native_list_pop_back, true});
+        driver.register_native_proc({"list_pop_front", Intrinsics::native_list_pop_front, true});
+        driver.register_native_proc({"list_concat", Intrinsics::native_list_concat});
+
+        return driver;
+    }
+}
+
+#endif
@@ -1,5 +1,5 @@
 handle_usage_and_exit() {
-    echo "USAGE:\n\n./try_test_suite.sh [help | run] [args...]\n\thelp []: prints usage information.\n\trun [neg | pos] [simple | unused]: runs the specified groups of test programs.\n";
+    echo "USAGE:\n\n./try_test_suite.sh [help | run | modes] [args...]\n\thelp []: prints usage information.\n\trun [neg | pos] [simple | unused] [run-options...]: runs the specified groups of test programs, passing any run options to minuetm.\n\tmodes []: runs the simple group under every VM mode.\n";
     exit $1;
 }
 
@@ -11,19 +11,34 @@ handle_suite_group() {
     fi
 
     tests=$( find ./test_suite/$2/*.mnl );
+    run_opts="${@:3}";
 
     for test_path in $tests
     do
-        ./build/src/minuetm run $test_path;
+        ./build/src/minuetm run $test_path $run_opts;
 
         if [[ $? -ne $check_status ]]; then
-            echo "\033[1;31mFAILED on demo '$test_path'\033[0m";
+            echo "\033[1;31mFAILED on demo '$test_path' $run_opts\033[0m";
         else
-            echo "\033[1;32mCOMPLETED demo '$test_path'\033[0m";
+            echo "\033[1;32mCOMPLETED demo '$test_path' $run_opts\033[0m";
         fi
     done
 }
 
+handle_modes() {
+    handle_suite_group "pos" "simple"
+    handle_suite_group "pos" "simple" "--quicken"
+    handle_suite_group "pos" "simple" "--no-feedback"
+    handle_suite_group "pos" "simple" "--quicken" "--no-feedback"
+    handle_suite_group "pos" "simple" "--slice" "16"
+    handle_suite_group "pos" "simple" "--jit" "1"
+    handle_suite_group "pos" "simple" "--trace" "1"
+    handle_suite_group "pos" "simple" "--gc-pause" "1"
+    handle_suite_group "pos" "simple" "--gc-threads" "4"
+    handle_suite_group "pos" "simple" "--gc-pause" "1" "--heap-report-gc"
+    handle_suite_group "pos" "simple" "--jobs" "4" "--repeat" "3"
+}
+
 handle_action() {
     argc=$#;
     action="$1";
@@ -34,8 +49,11 @@ handle_action() {
 
     if [[ $action = "help" ]]; then
         handle_usage_and_exit 0;
-    elif [[ $action = "run" && $argc -eq 3 ]]; then
-        handle_suite_group "$2" "$3"
+    elif [[ $action = "run" && $argc -ge 3 ]]; then
+        handle_suite_group "${@:2}"
+    elif [[ $action = "modes" ]]; then
+        # unattended, so prompts read EOF instead of waiting on the terminal
+        handle_modes < /dev/null;
     else
         handle_usage_and_exit 1;
     fi